@@ -2,6 +2,7 @@
 #include <numbers>
 #include <cmath>
 #include <cassert>
+#include <algorithm>
 
 class Triangle {
 private:
@@ -11,11 +12,13 @@ public:
     Triangle(double first, double second, double third) 
         : side1(first), side2(second), side3(third) {}
 
+    // Формула Герона в форме Кахана: устойчива для "игольчатых" треугольников
     double area() const {
-        double semiPerimeter = perimeter() / 2.0;
-        double product = semiPerimeter * (semiPerimeter - side1) * 
-                        (semiPerimeter - side2) * (semiPerimeter - side3);
-        return std::sqrt(product);
+        double a = std::max({side1, side2, side3});
+        double c = std::min({side1, side2, side3});
+        double b = std::max(std::min(side1, side2), std::min(std::max(side1, side2), side3));
+        double product = (a + (b + c)) * (c - (a - b)) * (c + (a - b)) * (a + (b - c));
+        return 0.25 * std::sqrt(product);
     }
 
     double perimeter() const {
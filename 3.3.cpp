@@ -1,7 +1,27 @@
 #include <iostream>
 #include <cassert>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <atomic>
+#include <array>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
 
-class List {
+// Исходный односвязный вариант: pop_back проходит весь список за O(n)
+class SinglyLinkedList {
 private:
     struct Node {
         int value;
@@ -14,7 +34,7 @@ private:
     Node* tailPtr;
 
 public:
-    List() : headPtr(nullptr), tailPtr(nullptr) {}
+    SinglyLinkedList() : headPtr(nullptr), tailPtr(nullptr) {}
     
     bool empty() const {
         return headPtr == nullptr;
@@ -93,13 +113,1014 @@ public:
         return slowPtr->value;
     }
     
-    ~List() {
+    ~SinglyLinkedList() {
         while (!empty()) {
             pop_front();
         }
     }
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Распределители узлов для List
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+class HeapNodeAllocator {
+public:
+    template<typename... Args>
+    T* create(Args&&... args) {
+        return new T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T* node) {
+        delete node;
+    }
+
+    void merge(HeapNodeAllocator&) {}
+};
+
+struct PoolStatistics {
+    std::size_t liveNodes;
+    std::size_t freeNodes;
+    std::size_t chunks;
+};
+
+// Узлы нарезаются из блоков по nodesPerChunk штук, освобожденные узлы
+// складываются в интрузивный список свободных и переиспользуются
+template<typename T>
+class NodePool {
+private:
+    union Slot {
+        Slot* nextFree;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    // Блоки образуют интрузивный список: нулевой слот блока хранит указатель на следующий блок,
+    // узлы занимают слоты 1..nodesPerChunk. Так merge сцепляет блоки двух пулов за O(1)
+    Slot* firstChunk = nullptr;
+    Slot* lastChunk = nullptr;
+    std::size_t chunkCount = 0;
+    Slot* freeList = nullptr;
+    // хвост списка свободных слотов, чтобы merge сцеплял списки без обхода
+    Slot* freeTail = nullptr;
+    std::size_t nodesPerChunk;
+    std::size_t liveNodes = 0;
+    std::size_t freeNodes = 0;
+
+    void grow() {
+        Slot* chunk = new Slot[nodesPerChunk + 1];
+        chunk[0].nextFree = nullptr;
+        if (lastChunk != nullptr) {
+            lastChunk[0].nextFree = chunk;
+        } else {
+            firstChunk = chunk;
+        }
+        lastChunk = chunk;
+        ++chunkCount;
+        if (freeList == nullptr) {
+            freeTail = &chunk[nodesPerChunk];
+        }
+        for (std::size_t i = nodesPerChunk; i > 0; --i) {
+            chunk[i].nextFree = freeList;
+            freeList = &chunk[i];
+        }
+        freeNodes += nodesPerChunk;
+    }
+
+    void deleteChunks() {
+        for (Slot* chunk = firstChunk; chunk != nullptr;) {
+            Slot* next = chunk[0].nextFree;
+            delete[] chunk;
+            chunk = next;
+        }
+        firstChunk = lastChunk = nullptr;
+        chunkCount = 0;
+    }
+
+public:
+    explicit NodePool(std::size_t chunkSize = 256) : nodesPerChunk(chunkSize) {}
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    ~NodePool() {
+        assert(liveNodes == 0);
+        deleteChunks();
+    }
+
+    template<typename... Args>
+    T* create(Args&&... args) {
+        if (freeList == nullptr) {
+            grow();
+        }
+        Slot* slot = freeList;
+        Slot* next = slot->nextFree;
+        T* node;
+        try {
+            node = ::new (slot->storage) T(std::forward<Args>(args)...);
+        } catch (...) {
+            // слот остается первым свободным; конструктор мог затереть его ссылку
+            slot->nextFree = next;
+            throw;
+        }
+        freeList = next;
+        if (freeList == nullptr) {
+            freeTail = nullptr;
+        }
+        --freeNodes;
+        ++liveNodes;
+        return node;
+    }
+
+    void destroy(T* node) {
+        node->~T();
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        if (freeList == nullptr) {
+            freeTail = slot;
+        }
+        slot->nextFree = freeList;
+        freeList = slot;
+        ++freeNodes;
+        --liveNodes;
+    }
+
+    PoolStatistics statistics() const {
+        return {liveNodes, freeNodes, chunkCount};
+    }
+
+    // Забирает за O(1) блоки другого пула вместе с его живыми и свободными узлами (нужно для splice).
+    // Пулы должны нарезать блоки одного размера
+    void merge(NodePool& other) {
+        if (&other == this) return;
+        assert(other.nodesPerChunk == nodesPerChunk);
+        if (other.firstChunk != nullptr) {
+            if (lastChunk != nullptr) {
+                lastChunk[0].nextFree = other.firstChunk;
+            } else {
+                firstChunk = other.firstChunk;
+            }
+            lastChunk = other.lastChunk;
+            chunkCount += other.chunkCount;
+        }
+        if (other.freeList != nullptr) {
+            other.freeTail->nextFree = freeList;
+            if (freeList == nullptr) {
+                freeTail = other.freeTail;
+            }
+            freeList = other.freeList;
+        }
+        liveNodes += other.liveNodes;
+        freeNodes += other.freeNodes;
+        other.firstChunk = other.lastChunk = nullptr;
+        other.chunkCount = 0;
+        other.freeList = nullptr;
+        other.freeTail = nullptr;
+        other.liveNodes = 0;
+        other.freeNodes = 0;
+    }
+
+    // Возвращает системе блоки, в которых не осталось живых узлов
+    void releaseMemory() {
+        if (liveNodes == 0) {
+            deleteChunks();
+            freeList = nullptr;
+            freeTail = nullptr;
+            freeNodes = 0;
+            return;
+        }
+        std::vector<Slot*> chunks;
+        chunks.reserve(chunkCount);
+        for (Slot* chunk = firstChunk; chunk != nullptr; chunk = chunk[0].nextFree) {
+            chunks.push_back(chunk);
+        }
+        std::sort(chunks.begin(), chunks.end(), std::less<Slot*>());
+        auto chunkOf = [&](Slot* slot) {
+            auto it = std::upper_bound(chunks.begin(), chunks.end(), slot, std::less<Slot*>());
+            return static_cast<std::size_t>(it - chunks.begin()) - 1;
+        };
+        std::vector<std::size_t> freeInChunk(chunks.size(), 0);
+        for (Slot* slot = freeList; slot != nullptr; slot = slot->nextFree) {
+            ++freeInChunk[chunkOf(slot)];
+        }
+        Slot** link = &freeList;
+        freeTail = nullptr;
+        while (*link != nullptr) {
+            if (freeInChunk[chunkOf(*link)] == nodesPerChunk) {
+                *link = (*link)->nextFree;
+                --freeNodes;
+            } else {
+                freeTail = *link;
+                link = &(*link)->nextFree;
+            }
+        }
+        firstChunk = lastChunk = nullptr;
+        chunkCount = 0;
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            if (freeInChunk[i] == nodesPerChunk) {
+                delete[] chunks[i];
+                continue;
+            }
+            chunks[i][0].nextFree = nullptr;
+            if (lastChunk != nullptr) {
+                lastChunk[0].nextFree = chunks[i];
+            } else {
+                firstChunk = chunks[i];
+            }
+            lastChunk = chunks[i];
+            ++chunkCount;
+        }
+    }
+};
+
+template<template<typename> class NodeAllocator = NodePool>
+class BasicList {
+private:
+    struct Node {
+        int value;
+        Node* prev;
+        Node* next;
+        
+        Node(int val) : value(val), prev(nullptr), next(nullptr) {}
+    };
+    
+    Node* headPtr;
+    Node* tailPtr;
+    std::size_t elementCount;
+    // средний элемент с позицией (elementCount - 1) / 2, поддерживается при каждом изменении;
+    // nullptr в непустом списке означает, что после splice/sort его надо найти заново
+    mutable Node* middlePtr;
+    NodeAllocator<Node> nodes;
+
+    // устойчивое слияние двух цепочек по next; при равенстве первым идет узел из left
+    template<typename Compare>
+    static Node* merge(Node* left, Node* right, Compare& compare) {
+        Node chain(0);
+        Node* tail = &chain;
+        while (left != nullptr && right != nullptr) {
+            if (compare(right->value, left->value)) {
+                tail->next = right;
+                right = right->next;
+            } else {
+                tail->next = left;
+                left = left->next;
+            }
+            tail = tail->next;
+        }
+        tail->next = left != nullptr ? left : right;
+        return chain.next;
+    }
+
+    template<bool IsConst>
+    class Iterator {
+    private:
+        Node* node = nullptr;
+
+        friend class BasicList;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = int;
+        using pointer = std::conditional_t<IsConst, const int*, int*>;
+        using reference = std::conditional_t<IsConst, const int&, int&>;
+
+        Iterator() = default;
+        explicit Iterator(Node* element) : node(element) {}
+
+        operator Iterator<true>() const {
+            return Iterator<true>(node);
+        }
+
+        reference operator*() const {
+            return node->value;
+        }
+
+        pointer operator->() const {
+            return &node->value;
+        }
+
+        Iterator& operator++() {
+            node = node->next;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+            return lhs.node == rhs.node;
+        }
+    };
+
+public:
+    BasicList() : headPtr(nullptr), tailPtr(nullptr), elementCount(0), middlePtr(nullptr) {}
+
+    BasicList(const BasicList&) = delete;
+    BasicList& operator=(const BasicList&) = delete;
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    iterator begin() { return iterator(headPtr); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(headPtr); }
+    const_iterator end() const { return const_iterator(); }
+
+    NodeAllocator<Node>& allocator() {
+        return nodes;
+    }
+
+    const NodeAllocator<Node>& allocator() const {
+        return nodes;
+    }
+    
+    bool empty() const {
+        return headPtr == nullptr;
+    }
+
+    std::size_t size() const {
+        return elementCount;
+    }
+
+    std::size_t middleIndex() const {
+        return empty() ? 0 : (elementCount - 1) / 2;
+    }
+
+    template<typename F>
+    void forEach(F&& visitor) const {
+        for (Node* iterator = headPtr; iterator != nullptr; iterator = iterator->next) {
+            visitor(iterator->value);
+        }
+    }
+    
+    void show() const {
+        forEach([](int value) { std::cout << value << " "; });
+        std::cout << std::endl;
+    }
+
+    void push_front(int value) {
+        Node* newElement = nodes.create(value);
+        if (!empty()) {
+            newElement->next = headPtr;
+            headPtr->prev = newElement;
+            headPtr = newElement;
+            // все позиции сдвинулись на 1; при нечетном размере середина остается на месте
+            if (middlePtr != nullptr && elementCount % 2 == 1) {
+                middlePtr = middlePtr->prev;
+            }
+        } else {
+            headPtr = newElement;
+            tailPtr = newElement;
+            middlePtr = newElement;
+        }
+        ++elementCount;
+    }
+
+    void push_back(int value) {
+        Node* newElement = nodes.create(value);
+        if (!empty()) {
+            newElement->prev = tailPtr;
+            tailPtr->next = newElement;
+            tailPtr = newElement;
+            if (middlePtr != nullptr && elementCount % 2 == 0) {
+                middlePtr = middlePtr->next;
+            }
+        } else {
+            headPtr = newElement;
+            tailPtr = newElement;
+            middlePtr = newElement;
+        }
+        ++elementCount;
+    }
+
+    void pop_front() {
+        if (empty()) return;
+        if (middlePtr != nullptr && elementCount % 2 == 0) {
+            middlePtr = middlePtr->next;
+        }
+        Node* nextElement = headPtr->next;
+        nodes.destroy(headPtr);
+        headPtr = nextElement;
+        if (headPtr == nullptr) {
+            tailPtr = nullptr;
+        } else {
+            headPtr->prev = nullptr;
+        }
+        --elementCount;
+    }
+
+    // O(1): предшественник хвоста известен по указателю prev
+    void pop_back() {
+        if (empty()) return;
+        if (middlePtr != nullptr && elementCount % 2 == 1) {
+            middlePtr = middlePtr->prev;
+        }
+        Node* prevElement = tailPtr->prev;
+        nodes.destroy(tailPtr);
+        tailPtr = prevElement;
+        if (tailPtr == nullptr) {
+            headPtr = nullptr;
+        } else {
+            tailPtr->next = nullptr;
+        }
+        --elementCount;
+    }
+
+    int front() const {
+        return empty() ? -1 : headPtr->value;
+    }
+
+    int back() const {
+        return empty() ? -1 : tailPtr->value;
+    }
+
+    // O(1): середина сдвигается не более чем на один узел за операцию
+    int get() const {
+        if (empty()) return -1;
+        if (middlePtr == nullptr) {
+            middlePtr = headPtr;
+            for (std::size_t i = 0; i < middleIndex(); ++i) {
+                middlePtr = middlePtr->next;
+            }
+        }
+        return middlePtr->value;
+    }
+
+    // Все узлы из range собираются в отдельную цепочку и присоединяются к хвосту одной операцией;
+    // если range или создание узла бросает исключение, цепочка возвращается распределителю
+    // и список не меняется
+    template<std::ranges::input_range Range>
+    void append(Range&& range) {
+        Node chain(0);
+        Node* last = &chain;
+        std::size_t added = 0;
+        try {
+            for (int value : range) {
+                Node* newElement = nodes.create(value);
+                newElement->prev = last;
+                last->next = newElement;
+                last = newElement;
+                ++added;
+            }
+        } catch (...) {
+            for (Node* node = chain.next; added > 0; --added) {
+                Node* next = node->next;
+                nodes.destroy(node);
+                node = next;
+            }
+            throw;
+        }
+        if (added == 0) return;
+        std::size_t oldMiddle = middleIndex();
+        bool wasEmpty = empty();
+        chain.next->prev = tailPtr;
+        (wasEmpty ? headPtr : tailPtr->next) = chain.next;
+        tailPtr = last;
+        elementCount += added;
+        if (wasEmpty) {
+            middlePtr = headPtr;
+            oldMiddle = 0;
+        }
+        if (middlePtr != nullptr) {
+            for (std::size_t i = oldMiddle; i < middleIndex(); ++i) {
+                middlePtr = middlePtr->next;
+            }
+        }
+    }
+
+    // O(1) перенос всех узлов other в конец списка; other становится пустым
+    void splice_back(BasicList& other) {
+        if (&other == this || other.empty()) return;
+        nodes.merge(other.nodes);
+        if (empty()) {
+            headPtr = other.headPtr;
+        } else {
+            tailPtr->next = other.headPtr;
+            other.headPtr->prev = tailPtr;
+        }
+        tailPtr = other.tailPtr;
+        elementCount += other.elementCount;
+        middlePtr = nullptr;
+        other.headPtr = other.tailPtr = other.middlePtr = nullptr;
+        other.elementCount = 0;
+    }
+
+    // Восходящая сортировка слиянием: только перестановка указателей, без выделений.
+    // bins[i] хранит отсортированную цепочку из 2^i узлов, как при двоичном счете
+    template<typename Compare = std::less<int>>
+    void sort(Compare compare = Compare()) {
+        if (elementCount < 2) return;
+        std::array<Node*, 64> bins{};
+        Node* current = headPtr;
+        while (current != nullptr) {
+            Node* carry = current;
+            current = current->next;
+            carry->next = nullptr;
+            std::size_t i = 0;
+            for (; bins[i] != nullptr; ++i) {
+                carry = merge(bins[i], carry, compare);
+                bins[i] = nullptr;
+            }
+            bins[i] = carry;
+        }
+        Node* sorted = nullptr;
+        for (Node* bin : bins) {
+            if (bin != nullptr) {
+                sorted = merge(bin, sorted, compare);
+            }
+        }
+        headPtr = sorted;
+        Node* previous = nullptr;
+        for (Node* node = headPtr; node != nullptr; node = node->next) {
+            node->prev = previous;
+            previous = node;
+        }
+        headPtr->prev = nullptr;
+        tailPtr = previous;
+        middlePtr = nullptr;
+    }
+    
+    ~BasicList() {
+        while (!empty()) {
+            pop_front();
+        }
+    }
+};
+
+using List = BasicList<>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Развернутый список: в каждом узле хранится небольшой массив значений,
+// так что обход делает один переход по указателю на несколько элементов
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<std::size_t NodeBytes = 64, template<typename> class NodeAllocator = NodePool>
+class UnrolledList {
+private:
+    static constexpr std::size_t capacity =
+        (NodeBytes - 2 * sizeof(void*) - 2 * sizeof(std::uint16_t)) / sizeof(int);
+    static_assert(capacity >= 2 && capacity <= UINT16_MAX, "node must hold at least two values");
+
+    // значения узла лежат в values[first, last)
+    struct Node {
+        Node* prev = nullptr;
+        Node* next = nullptr;
+        std::uint16_t first;
+        std::uint16_t last;
+        int values[capacity];
+
+        explicit Node(std::size_t position)
+            : first(static_cast<std::uint16_t>(position)), last(static_cast<std::uint16_t>(position)) {}
+    };
+
+    Node* headPtr = nullptr;
+    Node* tailPtr = nullptr;
+    std::size_t elementCount = 0;
+    NodeAllocator<Node> nodes;
+
+    void unlink(Node* node) {
+        (node->prev != nullptr ? node->prev->next : headPtr) = node->next;
+        (node->next != nullptr ? node->next->prev : tailPtr) = node->prev;
+        nodes.destroy(node);
+    }
+
+public:
+    UnrolledList() = default;
+
+    UnrolledList(const UnrolledList&) = delete;
+    UnrolledList& operator=(const UnrolledList&) = delete;
+
+    static constexpr std::size_t valuesPerNode() {
+        return capacity;
+    }
+
+    bool empty() const {
+        return elementCount == 0;
+    }
+
+    std::size_t size() const {
+        return elementCount;
+    }
+
+    template<typename F>
+    void forEach(F&& visitor) const {
+        for (Node* node = headPtr; node != nullptr; node = node->next) {
+            for (std::size_t i = node->first; i < node->last; ++i) {
+                visitor(node->values[i]);
+            }
+        }
+    }
+
+    void show() const {
+        forEach([](int value) { std::cout << value << " "; });
+        std::cout << std::endl;
+    }
+
+    void push_front(int value) {
+        if (headPtr == nullptr || headPtr->first == 0) {
+            Node* newNode = nodes.create(capacity);
+            newNode->next = headPtr;
+            (headPtr != nullptr ? headPtr->prev : tailPtr) = newNode;
+            headPtr = newNode;
+        }
+        headPtr->values[--headPtr->first] = value;
+        ++elementCount;
+    }
+
+    void push_back(int value) {
+        if (tailPtr == nullptr || tailPtr->last == capacity) {
+            Node* newNode = nodes.create(0);
+            newNode->prev = tailPtr;
+            (tailPtr != nullptr ? tailPtr->next : headPtr) = newNode;
+            tailPtr = newNode;
+        }
+        tailPtr->values[tailPtr->last++] = value;
+        ++elementCount;
+    }
+
+    void pop_front() {
+        if (empty()) return;
+        if (++headPtr->first == headPtr->last) {
+            unlink(headPtr);
+        }
+        --elementCount;
+    }
+
+    void pop_back() {
+        if (empty()) return;
+        if (--tailPtr->last == tailPtr->first) {
+            unlink(tailPtr);
+        }
+        --elementCount;
+    }
+
+    // тот же средний элемент, что и у List::get(): позиция (size - 1) / 2
+    int get() const {
+        if (empty()) return -1;
+        std::size_t position = (elementCount - 1) / 2;
+        Node* node = headPtr;
+        while (position >= static_cast<std::size_t>(node->last - node->first)) {
+            position -= node->last - node->first;
+            node = node->next;
+        }
+        return node->values[node->first + position];
+    }
+
+    ~UnrolledList() {
+        while (headPtr != nullptr) {
+            unlink(headPtr);
+        }
+    }
+};
+
+template<typename F>
+long long measureMicroseconds(F&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Очереди для обмена между потоками с тем же словарем push_back / pop_front / empty
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Hazard pointers: поток публикует указатели, которые сейчас читает, а удаление
+// снятых с очереди узлов откладывается, пока их не перестанут публиковать
+// Одновременно указатели опасности могут держать не более maxThreads потоков
+class HazardPointers {
+public:
+    static constexpr std::size_t maxThreads = 128;
+    static constexpr std::size_t slotsPerThread = 2;
+
+private:
+    struct alignas(64) Record {
+        std::atomic<bool> active{false};
+        std::array<std::atomic<void*>, slotsPerThread> hazards{};
+    };
+
+    struct Retired {
+        void* pointer;
+        void (*deleter)(void*);
+    };
+
+    // запись потока и его отложенные удаления; при выходе потока они попадают в общий список
+    // сирот, и тот сразу просматривается: удаляется все, что уже никем не защищено
+    struct ThreadState {
+        Record* record = nullptr;
+        std::vector<Retired> retired;
+
+        ~ThreadState() {
+            if (record != nullptr) {
+                for (auto& hazard : record->hazards) hazard.store(nullptr);
+            }
+            {
+                std::lock_guard<std::mutex> lock(orphanMutex());
+                orphans().retired.insert(orphans().retired.end(), retired.begin(), retired.end());
+                scan(orphans().retired);
+            }
+            if (record != nullptr) {
+                record->active.store(false);
+            }
+        }
+    };
+
+    // остаток сирот удаляется при разрушении домена, когда потоков с указателями опасности уже нет
+    struct OrphanList {
+        std::vector<Retired> retired;
+
+        ~OrphanList() {
+            for (const Retired& item : retired) item.deleter(item.pointer);
+        }
+    };
+
+    static std::array<Record, maxThreads>& records() {
+        static std::array<Record, maxThreads> table;
+        return table;
+    }
+
+    static std::mutex& orphanMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static OrphanList& orphans() {
+        static OrphanList list;
+        return list;
+    }
+
+    static ThreadState& state() {
+        thread_local ThreadState threadState;
+        if (threadState.record == nullptr) {
+            for (Record& record : records()) {
+                bool expected = false;
+                if (record.active.compare_exchange_strong(expected, true)) {
+                    threadState.record = &record;
+                    break;
+                }
+            }
+            // без записи поток не может защитить указатель: protect, clear и retire бросают исключение
+            if (threadState.record == nullptr) {
+                throw std::runtime_error("HazardPointers: more than maxThreads threads at once");
+            }
+        }
+        return threadState;
+    }
+
+    static void scan(std::vector<Retired>& retired) {
+        std::vector<void*> protectedPointers;
+        for (Record& record : records()) {
+            if (!record.active.load()) continue;
+            for (auto& hazard : record.hazards) {
+                if (void* pointer = hazard.load()) protectedPointers.push_back(pointer);
+            }
+        }
+        std::sort(protectedPointers.begin(), protectedPointers.end());
+        std::erase_if(retired, [&](const Retired& item) {
+            if (std::binary_search(protectedPointers.begin(), protectedPointers.end(), item.pointer)) {
+                return false;
+            }
+            item.deleter(item.pointer);
+            return true;
+        });
+    }
+
+public:
+    template<typename T>
+    static T* protect(std::size_t slot, const std::atomic<T*>& source) {
+        std::atomic<void*>& hazard = state().record->hazards[slot];
+        T* pointer = source.load();
+        while (true) {
+            hazard.store(pointer);
+            T* current = source.load();
+            if (current == pointer) return pointer;
+            pointer = current;
+        }
+    }
+
+    static void clear() {
+        for (auto& hazard : state().record->hazards) hazard.store(nullptr);
+    }
+
+    template<typename T>
+    static void retire(T* pointer) {
+        ThreadState& threadState = state();
+        threadState.retired.push_back({pointer, [](void* object) { delete static_cast<T*>(object); }});
+        if (threadState.retired.size() >= 2 * maxThreads * slotsPerThread) {
+            {
+                std::lock_guard<std::mutex> lock(orphanMutex());
+                threadState.retired.insert(threadState.retired.end(), orphans().retired.begin(), orphans().retired.end());
+                orphans().retired.clear();
+            }
+            scan(threadState.retired);
+        }
+    }
+};
+
+// Неограниченная MPMC-очередь Майкла-Скотта без блокировок
+class LockFreeQueue {
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        int value;
+
+        explicit Node(int val) : value(val) {}
+    };
+
+    alignas(64) std::atomic<Node*> headPtr;
+    alignas(64) std::atomic<Node*> tailPtr;
+
+public:
+    LockFreeQueue() {
+        Node* dummy = new Node(0);
+        headPtr.store(dummy);
+        tailPtr.store(dummy);
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    ~LockFreeQueue() {
+        Node* node = headPtr.load();
+        while (node != nullptr) {
+            Node* next = node->next.load();
+            delete node;
+            node = next;
+        }
+    }
+
+    void push_back(int value) {
+        Node* newElement = new Node(value);
+        while (true) {
+            Node* tail = HazardPointers::protect(0, tailPtr);
+            Node* next = tail->next.load();
+            if (tail != tailPtr.load()) continue;
+            if (next != nullptr) {
+                tailPtr.compare_exchange_weak(tail, next);
+                continue;
+            }
+            if (tail->next.compare_exchange_weak(next, newElement)) {
+                tailPtr.compare_exchange_strong(tail, newElement);
+                break;
+            }
+        }
+        HazardPointers::clear();
+    }
+
+    std::optional<int> pop_front() {
+        while (true) {
+            Node* head = HazardPointers::protect(0, headPtr);
+            Node* tail = tailPtr.load();
+            Node* next = HazardPointers::protect(1, head->next);
+            if (head != headPtr.load()) continue;
+            if (next == nullptr) {
+                HazardPointers::clear();
+                return std::nullopt;
+            }
+            if (head == tail) {
+                tailPtr.compare_exchange_weak(tail, next);
+                continue;
+            }
+            int value = next->value;
+            if (headPtr.compare_exchange_weak(head, next)) {
+                HazardPointers::clear();
+                HazardPointers::retire(head);
+                return value;
+            }
+        }
+    }
+
+    bool empty() const {
+        Node* head = HazardPointers::protect(0, headPtr);
+        bool result = head->next.load() == nullptr;
+        HazardPointers::clear();
+        return result;
+    }
+};
+
+// Ограниченное кольцо для одного производителя и одного потребителя
+template<std::size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+private:
+    std::array<int, Capacity> buffer;
+    alignas(64) std::atomic<std::size_t> readIndex{0};
+    std::size_t cachedWriteIndex = 0;
+    alignas(64) std::atomic<std::size_t> writeIndex{0};
+    std::size_t cachedReadIndex = 0;
+
+public:
+    // false, если кольцо заполнено
+    bool push_back(int value) {
+        std::size_t write = writeIndex.load(std::memory_order_relaxed);
+        if (write - cachedReadIndex == Capacity) {
+            cachedReadIndex = readIndex.load(std::memory_order_acquire);
+            if (write - cachedReadIndex == Capacity) return false;
+        }
+        buffer[write & (Capacity - 1)] = value;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<int> pop_front() {
+        std::size_t read = readIndex.load(std::memory_order_relaxed);
+        if (read == cachedWriteIndex) {
+            cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+            if (read == cachedWriteIndex) return std::nullopt;
+        }
+        int value = buffer[read & (Capacity - 1)];
+        readIndex.store(read + 1, std::memory_order_release);
+        return value;
+    }
+
+    bool empty() const {
+        return readIndex.load(std::memory_order_acquire) == writeIndex.load(std::memory_order_acquire);
+    }
+};
+
+// То, чем пользовались раньше: List под мьютексом
+class LockedList {
+private:
+    mutable std::mutex mutex;
+    List list;
+
+public:
+    void push_back(int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.push_back(value);
+    }
+
+    std::optional<int> pop_front() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.empty()) return std::nullopt;
+        int value = list.front();
+        list.pop_front();
+        return value;
+    }
+
+    bool empty() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return list.empty();
+    }
+};
+
+// producers потоков кладут по itemsPerProducer различных значений, consumers забирают их;
+// возвращает время и сумму забранных значений
+template<typename Queue>
+std::pair<long long, long long> queueContention(Queue& queue, int producers, int consumers, int itemsPerProducer) {
+    std::atomic<long long> total{0};
+    std::atomic<int> remaining{producers * itemsPerProducer};
+    long long time = measureMicroseconds([&] {
+        std::vector<std::thread> threads;
+        for (int producer = 0; producer < producers; ++producer) {
+            threads.emplace_back([&, producer] {
+                for (int i = 0; i < itemsPerProducer; ++i) {
+                    queue.push_back(producer * itemsPerProducer + i);
+                }
+            });
+        }
+        for (int consumer = 0; consumer < consumers; ++consumer) {
+            threads.emplace_back([&] {
+                long long local = 0;
+                while (remaining.load(std::memory_order_relaxed) > 0) {
+                    if (std::optional<int> value = queue.pop_front()) {
+                        local += *value;
+                        remaining.fetch_sub(1, std::memory_order_relaxed);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+                total += local;
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    });
+    return {time, total.load()};
+}
+
+// смешанная нагрузка: список держится около size элементов, операции чередуются на обоих концах
+template<typename ListType>
+long long mixedWorkload(std::size_t size, std::size_t rounds) {
+    ListType list;
+    for (std::size_t i = 0; i < size; ++i) {
+        list.push_back(static_cast<int>(i));
+    }
+    return measureMicroseconds([&] {
+        for (std::size_t i = 0; i < rounds; ++i) {
+            list.push_back(static_cast<int>(i));
+            list.pop_back();
+            list.pop_back();
+            list.push_front(static_cast<int>(i));
+        }
+    });
+}
+
 int main() {
     List testList;
     assert(testList.empty());
@@ -132,5 +1153,435 @@ int main() {
     assert(testList.get() == 1);
     std::cout << "The middle element for size 2 is correct" << std::endl;
 
+    assert(testList.size() == 2);
+    testList.pop_back();
+    testList.pop_back();
+    testList.pop_back();
+    assert(testList.empty() && testList.size() == 0);
+    for (int i = 0; i < 10; ++i) {
+        testList.push_back(i);
+        testList.push_front(-i);
+    }
+    assert(testList.size() == 20);
+    for (int i = 0; i < 5; ++i) {
+        testList.pop_back();
+    }
+    assert(testList.size() == 15);
+    assert(testList.get() == -2);
+    std::cout << "Size and pop_back test is passed" << std::endl;
+
+    {
+        List pooled;
+        for (int i = 0; i < 1000; ++i) {
+            pooled.push_back(i);
+        }
+        PoolStatistics filled = pooled.allocator().statistics();
+        assert(filled.liveNodes == 1000 && filled.liveNodes + filled.freeNodes == filled.chunks * 256);
+        for (int i = 0; i < 1000; ++i) {
+            pooled.pop_front();
+            pooled.push_back(i);
+        }
+        assert(pooled.allocator().statistics().chunks == filled.chunks);
+        for (int i = 0; i < 900; ++i) {
+            pooled.pop_front();
+        }
+        pooled.allocator().releaseMemory();
+        PoolStatistics released = pooled.allocator().statistics();
+        assert(released.liveNodes == 100 && released.chunks < filled.chunks);
+        assert(released.liveNodes + released.freeNodes == released.chunks * 256);
+        for (int i = 0; i < 1000; ++i) {
+            pooled.push_front(i);
+        }
+        assert(pooled.size() == 1100 && pooled.get() == 450);
+        while (!pooled.empty()) {
+            pooled.pop_back();
+        }
+        pooled.allocator().releaseMemory();
+        assert(pooled.allocator().statistics().chunks == 0);
+
+        // цепочка merge: хвост свободного списка должен оставаться верным после каждого слияния
+        NodePool<int> target(4);
+        for (int round = 0; round < 3; ++round) {
+            NodePool<int> donor(4);
+            int* kept = donor.create(round);
+            donor.destroy(donor.create(-1));
+            target.merge(donor);
+            assert(donor.statistics().chunks == 0 && donor.statistics().freeNodes == 0);
+            target.destroy(kept);
+        }
+        PoolStatistics merged = target.statistics();
+        assert(merged.liveNodes == 0 && merged.freeNodes == 12 && merged.chunks == 3);
+        std::vector<int*> reused;
+        for (int i = 0; i < 12; ++i) {
+            reused.push_back(target.create(i));
+        }
+        assert(target.statistics().chunks == 3);
+        for (int* node : reused) {
+            target.destroy(node);
+        }
+        target.releaseMemory();
+        assert(target.statistics().chunks == 0);
+
+        // конструктор бросил: слот возвращается в список свободных
+        struct Fragile {
+            explicit Fragile(bool fail) {
+                if (fail) throw std::runtime_error("Fragile");
+            }
+        };
+        NodePool<Fragile> fragile(2);
+        Fragile* first = fragile.create(false);
+        bool createThrows = false;
+        try {
+            fragile.create(true);
+        } catch (const std::runtime_error&) {
+            createThrows = true;
+        }
+        assert(createThrows && fragile.statistics().liveNodes == 1 && fragile.statistics().freeNodes == 1);
+        Fragile* second = fragile.create(false);
+        assert(second != first && fragile.statistics().chunks == 1 && fragile.statistics().freeNodes == 0);
+        fragile.destroy(first);
+        fragile.destroy(second);
+    }
+    std::cout << "Node pool test is passed" << std::endl;
+
+    // очередь с постоянной сменой узлов: пул против глобальных new/delete
+    auto churn = [](auto& list) {
+        return measureMicroseconds([&] {
+            for (int round = 0; round < 100; ++round) {
+                for (int i = 0; i < 10'000; ++i) {
+                    list.push_back(i);
+                }
+                for (int i = 0; i < 10'000; ++i) {
+                    list.pop_front();
+                }
+            }
+        });
+    };
+    BasicList<HeapNodeAllocator> heapList;
+    List pooledList;
+    long long heapTime = churn(heapList);
+    long long poolTime = churn(pooledList);
+    std::cout << "Push/pop churn of 2e6 operations: new/delete " << heapTime << " us, node pool "
+              << poolTime << " us" << std::endl;
+
+    {
+        UnrolledList<> unrolled;
+        List reference;
+        std::mt19937 generator(7);
+        for (int step = 0; step < 20'000; ++step) {
+            int value = static_cast<int>(generator() % 1000);
+            switch (generator() % 5) {
+            case 0: unrolled.push_front(value); reference.push_front(value); break;
+            case 1: unrolled.push_back(value); reference.push_back(value); break;
+            case 2: unrolled.pop_front(); reference.pop_front(); break;
+            case 3: unrolled.pop_back(); reference.pop_back(); break;
+            default: unrolled.push_back(value); reference.push_back(value); break;
+            }
+            assert(unrolled.size() == reference.size());
+            assert(unrolled.get() == reference.get());
+        }
+        std::vector<int> unrolledValues, referenceValues;
+        unrolled.forEach([&](int value) { unrolledValues.push_back(value); });
+        reference.forEach([&](int value) { referenceValues.push_back(value); });
+        assert(unrolledValues == referenceValues);
+        static_assert(UnrolledList<64>::valuesPerNode() == 11);
+    }
+    std::cout << "Unrolled list test is passed" << std::endl;
+
+    // обход и поиск среднего: узел на каждое значение против развернутых узлов
+    auto traversal = [](auto& list, const char* name) {
+        for (int i = 0; i < 1'000'000; ++i) {
+            list.push_back(i);
+        }
+        long long sum = 0;
+        long long traverseTime = measureMicroseconds([&] {
+            for (int round = 0; round < 10; ++round) {
+                list.forEach([&](int value) { sum += value; });
+            }
+        });
+        long long middleTime = measureMicroseconds([&] {
+            for (int round = 0; round < 10; ++round) {
+                sum += list.get();
+            }
+        });
+        assert(sum == 10LL * 999'999 * 1'000'000 / 2 + 10LL * 499'999);
+        std::cout << name << ": 10 traversals of 1e6 elements " << traverseTime
+                  << " us, 10 middle lookups " << middleTime << " us" << std::endl;
+    };
+    {
+        List plainList;
+        traversal(plainList, "List");
+        UnrolledList<64> unrolled64;
+        traversal(unrolled64, "UnrolledList<64>");
+        UnrolledList<256> unrolled256;
+        traversal(unrolled256, "UnrolledList<256>");
+    }
+
+    {
+        List incremental;
+        SinglyLinkedList walked;
+        std::mt19937 generator(33);
+        for (int step = 0; step < 20'000; ++step) {
+            int value = static_cast<int>(generator() % 1000);
+            switch (generator() % 6) {
+            case 0: incremental.push_front(value); walked.push_front(value); break;
+            case 1: incremental.push_back(value); walked.push_back(value); break;
+            case 2: incremental.pop_front(); walked.pop_front(); break;
+            case 3: incremental.pop_back(); walked.pop_back(); break;
+            case 4: incremental.push_front(value); walked.push_front(value); break;
+            default: incremental.push_back(value); walked.push_back(value); break;
+            }
+            assert(incremental.get() == walked.get());
+            assert(incremental.middleIndex() == (incremental.empty() ? 0 : (incremental.size() - 1) / 2));
+        }
+    }
+    std::cout << "Incremental middle test is passed" << std::endl;
+
+    // после каждого изменения запрашиваем середину: поддерживаемый указатель против прохода
+    auto medianQueries = [](auto& list, std::size_t size, int updates) {
+        for (std::size_t i = 0; i < size; ++i) {
+            list.push_back(static_cast<int>(i));
+        }
+        long long sum = 0;
+        long long time = measureMicroseconds([&] {
+            for (int i = 0; i < updates; ++i) {
+                if (i % 2 == 0) {
+                    list.push_back(i);
+                } else {
+                    list.pop_front();
+                }
+                sum += list.get();
+            }
+        });
+        return std::make_pair(time, sum);
+    };
+    for (std::size_t size : {10'000, 100'000}) {
+        List incremental;
+        SinglyLinkedList walked;
+        auto [incrementalTime, incrementalSum] = medianQueries(incremental, size, 2'000);
+        auto [walkTime, walkSum] = medianQueries(walked, size, 2'000);
+        assert(incrementalSum == walkSum);
+        std::cout << "2000 updates with middle queries at " << size << " elements: maintained pointer "
+                  << incrementalTime << " us, fast/slow walk " << walkTime << " us" << std::endl;
+    }
+
+    {
+        LockFreeQueue queue;
+        assert(queue.empty() && !queue.pop_front());
+        for (int i = 0; i < 5; ++i) {
+            queue.push_back(i);
+        }
+        assert(!queue.empty());
+        for (int i = 0; i < 5; ++i) {
+            assert(queue.pop_front() == i);
+        }
+        assert(queue.empty());
+
+        SpscRing<4> ring;
+        assert(ring.empty());
+        for (int i = 0; i < 4; ++i) {
+            assert(ring.push_back(i));
+        }
+        assert(!ring.push_back(4));
+        assert(ring.pop_front() == 0 && ring.push_back(4));
+        for (int i = 1; i <= 4; ++i) {
+            assert(ring.pop_front() == i);
+        }
+        assert(ring.empty() && !ring.pop_front());
+
+        const int items = 20'000;
+        const long long expected = 4LL * items * (4LL * items - 1) / 2;
+        assert(queueContention(queue, 4, 4, items).second == expected);
+        assert(queue.empty());
+
+        // объекты, отложенные потоком до порога просмотра, удаляются при его выходе
+        static std::atomic<int> retireesAlive{0};
+        struct Retiree {
+            Retiree() { ++retireesAlive; }
+            ~Retiree() { --retireesAlive; }
+        };
+        std::thread([] {
+            for (int i = 0; i < 10; ++i) HazardPointers::retire(new Retiree());
+        }).join();
+        assert(retireesAlive == 0);
+
+        // записи кончились: лишний поток получает исключение, а не падение
+        std::atomic<int> arrived{0}, exhausted{0};
+        std::atomic<bool> release{false};
+        std::atomic<int*> source{nullptr};
+        std::vector<std::thread> holders;
+        for (std::size_t i = 0; i <= HazardPointers::maxThreads; ++i) {
+            holders.emplace_back([&] {
+                try {
+                    HazardPointers::protect(0, source);
+                } catch (const std::runtime_error&) {
+                    ++exhausted;
+                }
+                ++arrived;
+                while (!release) std::this_thread::yield();
+            });
+        }
+        while (arrived <= static_cast<int>(HazardPointers::maxThreads)) std::this_thread::yield();
+        release = true;
+        for (std::thread& holder : holders) holder.join();
+        assert(exhausted >= 1);
+    }
+    std::cout << "Concurrent queues test is passed" << std::endl;
+
+    // конкуренция: 1..N производителей и потребителей
+    {
+        const int items = 200'000;
+        int maxThreads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+        for (int threads = 1; threads <= maxThreads / 2 || threads == 1; threads *= 2) {
+            LockFreeQueue lockFree;
+            LockedList locked;
+            auto [lockFreeTime, lockFreeSum] = queueContention(lockFree, threads, threads, items / threads);
+            auto [lockedTime, lockedSum] = queueContention(locked, threads, threads, items / threads);
+            assert(lockFreeSum == lockedSum);
+            std::cout << threads << " producers x " << threads << " consumers, " << items
+                      << " items: lock-free " << lockFreeTime << " us, mutex + List " << lockedTime << " us";
+            if (threads == 1) {
+                auto spsc = std::make_unique<SpscRing<1024>>();
+                auto pushRing = [&] {
+                    for (int i = 0; i < items; ++i) {
+                        while (!spsc->push_back(i)) std::this_thread::yield();
+                    }
+                };
+                long long spscSum = 0;
+                long long ringTime = measureMicroseconds([&] {
+                    std::thread producer(pushRing);
+                    for (int received = 0; received < items;) {
+                        if (std::optional<int> value = spsc->pop_front()) {
+                            spscSum += *value;
+                            ++received;
+                        } else {
+                            std::this_thread::yield();
+                        }
+                    }
+                    producer.join();
+                });
+                assert(spscSum == lockFreeSum);
+                std::cout << ", SPSC ring " << ringTime << " us";
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    {
+        static_assert(std::forward_iterator<List::iterator>);
+        static_assert(std::forward_iterator<List::const_iterator>);
+        List first, second;
+        std::vector<int> values{5, 3, 9, 1};
+        first.append(values);
+        assert(first.size() == 4 && first.back() == 1 && first.get() == 3);
+        for (int& value : first) {
+            value *= 2;
+        }
+        assert(std::ranges::equal(first, std::vector<int>{10, 6, 18, 2}));
+
+        second.push_back(7);
+        second.append(std::views::iota(0, 3));
+        first.splice_back(second);
+        assert(second.empty() && second.size() == 0 && second.get() == -1);
+        assert(first.size() == 8 && first.back() == 2 && first.get() == 2);
+        assert(std::ranges::equal(first, std::vector<int>{10, 6, 18, 2, 7, 0, 1, 2}));
+        second.push_back(100);
+        assert(second.front() == 100 && second.get() == 100);
+
+        first.sort();
+        assert(std::ranges::equal(first, std::vector<int>{0, 1, 2, 2, 6, 7, 10, 18}));
+        assert(first.front() == 0 && first.back() == 18 && first.get() == 2);
+        first.pop_back();
+        first.push_front(-1);
+        assert(first.get() == 2 && first.back() == 10);
+        first.sort(std::greater<int>());
+        assert(std::ranges::equal(first, std::vector<int>{10, 7, 6, 2, 2, 1, 0, -1}));
+        for (int i = 0; i < 8; ++i) {
+            first.pop_back();
+        }
+        assert(first.empty() && first.allocator().statistics().liveNodes == 0);
+
+        std::mt19937 generator(5);
+        List random;
+        std::vector<int> expected;
+        for (int i = 0; i < 1000; ++i) {
+            int value = static_cast<int>(generator() % 100);
+            random.push_back(value);
+            expected.push_back(value);
+        }
+        random.sort();
+        std::sort(expected.begin(), expected.end());
+        assert(std::ranges::equal(random, expected));
+        assert(random.get() == expected[499]);
+
+        // исключение посреди диапазона: список и пул остаются прежними
+        List partial;
+        partial.append(std::views::iota(0, 3));
+        auto failing = std::views::iota(10, 20) | std::views::transform([](int value) {
+            if (value == 15) throw std::runtime_error("bad value");
+            return value;
+        });
+        bool appendThrows = false;
+        try {
+            partial.append(failing);
+        } catch (const std::runtime_error&) {
+            appendThrows = true;
+        }
+        assert(appendThrows && partial.size() == 3 && partial.back() == 2 && partial.get() == 1);
+        assert(partial.allocator().statistics().liveNodes == 3);
+        partial.push_back(3);
+        assert(std::ranges::equal(partial, std::vector<int>{0, 1, 2, 3}));
+    }
+    std::cout << "Iterators, splice, append and sort test is passed" << std::endl;
+
+    // сортировка 1e6 узлов: перестановка указателей против копирования в std::vector и обратно
+    {
+        std::mt19937 generator(11);
+        std::vector<int> source(1'000'000);
+        for (int& value : source) {
+            value = static_cast<int>(generator());
+        }
+        List relinked, copied;
+        relinked.append(source);
+        copied.append(source);
+        long long mergeTime = measureMicroseconds([&] { relinked.sort(); });
+        long long vectorTime = measureMicroseconds([&] {
+            std::vector<int> buffer(copied.begin(), copied.end());
+            std::sort(buffer.begin(), buffer.end());
+            std::copy(buffer.begin(), buffer.end(), copied.begin());
+        });
+        assert(std::ranges::equal(relinked, copied));
+        // после сортировки слиянием узлы идут по памяти вразброс, что видно на обходе
+        long long sum = 0;
+        long long relinkedWalk = measureMicroseconds([&] { for (int value : relinked) sum += value; });
+        long long copiedWalk = measureMicroseconds([&] { for (int value : copied) sum -= value; });
+        assert(sum == 0);
+        std::cout << "Sorting 1e6 nodes: merge sort " << mergeTime << " us, via std::vector "
+                  << vectorTime << " us; traversal afterwards " << relinkedWalk << " us vs "
+                  << copiedWalk << " us" << std::endl;
+
+        List appended;
+        long long appendTime = measureMicroseconds([&] { appended.append(source); });
+        List pushed;
+        long long pushTime = measureMicroseconds([&] {
+            for (int value : source) pushed.push_back(value);
+        });
+        long long spliceTime = measureMicroseconds([&] { appended.splice_back(pushed); });
+        assert(appended.size() == 2 * source.size() && pushed.empty());
+        std::cout << "1e6 elements: append " << appendTime << " us, push_back loop " << pushTime
+                  << " us, splice " << spliceTime << " us" << std::endl;
+    }
+
+    const std::size_t rounds = 200;
+    for (std::size_t size : {10'000, 100'000, 1'000'000}) {
+        long long singlyTime = mixedWorkload<SinglyLinkedList>(size, rounds);
+        long long doublyTime = mixedWorkload<List>(size, rounds);
+        std::cout << "Mixed push/pop, " << size << " elements, " << 4 * rounds
+                  << " operations: singly linked " << singlyTime << " us, doubly linked "
+                  << doublyTime << " us" << std::endl;
+    }
+    long long doublyMillion = mixedWorkload<List>(1'000'000, 1'000'000);
+    std::cout << "Doubly linked, 4e6 operations at 1e6 elements: " << doublyMillion << " us" << std::endl;
+
     return 0;
 }
\ No newline at end of file
@@ -3,6 +3,43 @@
 #include <cmath>
 #include <cassert>
 #include <vector>
+#include <span>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <memory>
+#include <memory_resource>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <filesystem>
+#include <thread>
+#include <limits>
+#include <stdexcept>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+enum class ShapeKind : std::uint8_t { Triangle, Square, Circle };
+
+// Формула Герона в форме Кахана: устойчива для "игольчатых" треугольников
+inline double heronArea(double side1, double side2, double side3) {
+    double a = std::max({side1, side2, side3});
+    double c = std::min({side1, side2, side3});
+    double b = std::max(std::min(side1, side2), std::min(std::max(side1, side2), side3));
+    double product = (a + (b + c)) * (c - (a - b)) * (c + (a - b)) * (a + (b - c));
+    return 0.25 * std::sqrt(product);
+}
 
 class Shape {
 public:
@@ -10,6 +47,10 @@ public:
     
     virtual double perimeter() const = 0;
     virtual double area() const = 0;
+
+    // для сериализации: тип фигуры и до трех параметров (неиспользуемые равны 0)
+    virtual ShapeKind kind() const = 0;
+    virtual std::array<double, 3> parameters() const = 0;
 };
 
 class Triangle : public Shape {
@@ -21,15 +62,20 @@ public:
         : side1(first), side2(second), side3(third) {}
 
     double area() const override final {
-        double semiPerimeter = perimeter() / 2.0;
-        double product = semiPerimeter * (semiPerimeter - side1) * 
-                        (semiPerimeter - side2) * (semiPerimeter - side3);
-        return std::sqrt(product);
+        return heronArea(side1, side2, side3);
     }
 
     double perimeter() const override final {
         return side1 + side2 + side3;
     }
+
+    ShapeKind kind() const override final {
+        return ShapeKind::Triangle;
+    }
+
+    std::array<double, 3> parameters() const override final {
+        return {side1, side2, side3};
+    }
 };
 
 class Square final : public Shape {
@@ -46,6 +92,14 @@ public:
     double perimeter() const override {
         return 4.0 * sideLength;
     }
+
+    ShapeKind kind() const override {
+        return ShapeKind::Square;
+    }
+
+    std::array<double, 3> parameters() const override {
+        return {sideLength, 0.0, 0.0};
+    }
 };
 
 class Circle final : public Shape {
@@ -62,7 +116,530 @@ class Circle final : public Shape {
         double perimeter() const override {
             return 2.0 * std::numbers::pi * circleRadius;
         }
+
+        ShapeKind kind() const override {
+            return ShapeKind::Circle;
+        }
+
+        std::array<double, 3> parameters() const override {
+            return {circleRadius, 0.0, 0.0};
+        }
+    };
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Пакетные (SoA) ядра: площадь и периметр для целых массивов фигур за один проход
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Извлечение корня на месте, по 4 (AVX) или 2 (SSE2) значения за инструкцию
+inline void sqrtBatch(std::span<double> values) {
+    std::size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 4 <= values.size(); i += 4) {
+        _mm256_storeu_pd(values.data() + i, _mm256_sqrt_pd(_mm256_loadu_pd(values.data() + i)));
+    }
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+    for (; i + 2 <= values.size(); i += 2) {
+        _mm_storeu_pd(values.data() + i, _mm_sqrt_pd(_mm_loadu_pd(values.data() + i)));
+    }
+#endif
+    for (; i < values.size(); ++i) {
+        values[i] = std::sqrt(values[i]);
+    }
+}
+
+void triangleMetrics(std::span<const double> side1, std::span<const double> side2,
+                     std::span<const double> side3, std::span<double> area,
+                     std::span<double> perimeter) {
+    assert(side2.size() == side1.size() && side3.size() == side1.size());
+    assert(area.size() >= side1.size() && perimeter.size() >= side1.size());
+    for (std::size_t i = 0; i < side1.size(); ++i) {
+        double x = side1[i], y = side2[i], z = side3[i];
+        double a = std::max(std::max(x, y), z);
+        double c = std::min(std::min(x, y), z);
+        double b = std::max(std::min(x, y), std::min(std::max(x, y), z));
+        perimeter[i] = x + y + z;
+        area[i] = (a + (b + c)) * (c - (a - b)) * (c + (a - b)) * (a + (b - c));
+    }
+    sqrtBatch(area.first(side1.size()));
+    for (std::size_t i = 0; i < side1.size(); ++i) {
+        area[i] *= 0.25;
+    }
+}
+
+void squareMetrics(std::span<const double> side, std::span<double> area,
+                   std::span<double> perimeter) {
+    assert(area.size() >= side.size() && perimeter.size() >= side.size());
+    for (std::size_t i = 0; i < side.size(); ++i) {
+        area[i] = side[i] * side[i];
+        perimeter[i] = 4.0 * side[i];
+    }
+}
+
+void circleMetrics(std::span<const double> radius, std::span<double> area,
+                   std::span<double> perimeter) {
+    assert(area.size() >= radius.size() && perimeter.size() >= radius.size());
+    for (std::size_t i = 0; i < radius.size(); ++i) {
+        area[i] = std::numbers::pi * radius[i] * radius[i];
+        perimeter[i] = 2.0 * std::numbers::pi * radius[i];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Арены: фигуры размещаются подряд в больших блоках и освобождаются все разом
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Удалитель для объектов из арены: только вызывает деструктор, память возвращает reset()
+struct ArenaDeleter {
+    template<typename T>
+    void operator()(T* object) const {
+        std::destroy_at(object);
+    }
+};
+
+template<typename T>
+using ArenaPtr = std::unique_ptr<T, ArenaDeleter>;
+
+class ShapeArena {
+private:
+    std::vector<std::unique_ptr<std::byte[]>> chunks;
+    std::size_t chunkSize;
+    std::size_t currentChunk = 0;
+    std::size_t offset = 0;
+
+    void* allocate(std::size_t size, std::size_t alignment) {
+        // в новом блоке выравнивание может съесть до alignment - 1 байт
+        if (size > chunkSize || alignment - 1 > chunkSize - size) {
+            throw std::bad_alloc();
+        }
+        while (true) {
+            if (currentChunk < chunks.size()) {
+                // выравнивается сам адрес: начало блока выровнено только по умолчанию new
+                std::uintptr_t base = reinterpret_cast<std::uintptr_t>(chunks[currentChunk].get());
+                std::size_t aligned = static_cast<std::size_t>(
+                    ((base + offset + alignment - 1) & ~(std::uintptr_t(alignment) - 1)) - base);
+                if (aligned + size <= chunkSize) {
+                    offset = aligned + size;
+                    return chunks[currentChunk].get() + aligned;
+                }
+                if (currentChunk + 1 < chunks.size()) {
+                    ++currentChunk;
+                    offset = 0;
+                    continue;
+                }
+            }
+            chunks.push_back(std::make_unique_for_overwrite<std::byte[]>(chunkSize));
+            currentChunk = chunks.size() - 1;
+            offset = 0;
+        }
+    }
+
+public:
+    explicit ShapeArena(std::size_t bytesPerChunk = 64 * 1024) : chunkSize(bytesPerChunk) {}
+
+    ShapeArena(const ShapeArena&) = delete;
+    ShapeArena& operator=(const ShapeArena&) = delete;
+
+    template<typename T, typename... Args>
+    ArenaPtr<T> create(Args&&... args) {
+        void* memory = allocate(sizeof(T), alignof(T));
+        return ArenaPtr<T>(::new (memory) T(std::forward<Args>(args)...));
+    }
+
+    // O(1): все выданные ArenaPtr должны быть уничтожены до вызова; блоки переиспользуются
+    void reset() {
+        currentChunk = 0;
+        offset = 0;
+    }
+
+    void release() {
+        chunks.clear();
+        reset();
+    }
+
+    std::size_t reservedBytes() const { return chunks.size() * chunkSize; }
+};
+
+// Тот же интерфейс поверх std::pmr::monotonic_buffer_resource
+class PmrShapeArena {
+private:
+    std::pmr::monotonic_buffer_resource resource;
+
+public:
+    explicit PmrShapeArena(std::size_t initialSize = 64 * 1024) : resource(initialSize) {}
+
+    template<typename T, typename... Args>
+    ArenaPtr<T> create(Args&&... args) {
+        void* memory = resource.allocate(sizeof(T), alignof(T));
+        return ArenaPtr<T>(::new (memory) T(std::forward<Args>(args)...));
+    }
+
+    void reset() {
+        resource.release();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Бинарный формат коллекции фигур: заголовок, столбец тегов и три столбца параметров.
+// Каждый столбец выровнен на 64 байта, поэтому отображенный файл читается без разбора.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct ShapeFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    // метка пишется в родном порядке байт: файл с машины с другим порядком отвергается
+    std::uint32_t byteOrder;
+    std::uint32_t reserved;
+    std::uint64_t count;
+};
+
+struct ShapeFileLayout {
+    std::size_t tagsOffset;
+    std::array<std::size_t, 3> parameterOffsets;
+    std::size_t totalSize;
+
+    static constexpr std::size_t columnAlignment = 64;
+
+    static std::size_t alignUp(std::size_t value) {
+        return (value + columnAlignment - 1) & ~(columnAlignment - 1);
+    }
+
+    explicit ShapeFileLayout(std::size_t count) {
+        tagsOffset = alignUp(sizeof(ShapeFileHeader));
+        std::size_t position = alignUp(tagsOffset + count * sizeof(ShapeKind));
+        for (std::size_t& parameterOffset : parameterOffsets) {
+            parameterOffset = position;
+            position = alignUp(position + count * sizeof(double));
+        }
+        totalSize = position;
+    }
+};
+
+inline constexpr char shapeFileMagic[4] = {'S', 'H', 'P', 'B'};
+inline constexpr std::uint32_t shapeFileVersion = 2;
+inline constexpr std::uint32_t shapeFileByteOrder = 0x01020304;
+
+template<typename Range>
+bool writeShapeFile(const std::filesystem::path& path, const Range& shapes) {
+    std::size_t count = std::ranges::size(shapes);
+    ShapeFileLayout layout(count);
+    std::vector<std::byte> buffer(layout.totalSize);
+
+    ShapeFileHeader header{};
+    std::memcpy(header.magic, shapeFileMagic, sizeof(header.magic));
+    header.version = shapeFileVersion;
+    header.byteOrder = shapeFileByteOrder;
+    header.count = count;
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    std::size_t index = 0;
+    for (const auto& shape : shapes) {
+        ShapeKind kind = shape->kind();
+        std::array<double, 3> parameters = shape->parameters();
+        std::memcpy(buffer.data() + layout.tagsOffset + index, &kind, sizeof(kind));
+        for (std::size_t column = 0; column < parameters.size(); ++column) {
+            std::memcpy(buffer.data() + layout.parameterOffsets[column] + index * sizeof(double),
+                        &parameters[column], sizeof(double));
+        }
+        ++index;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    return static_cast<bool>(file);
+}
+
+// Отображает файл в память и отдает столбцы как span без копирования и выделений
+class ShapeFileView {
+private:
+    const std::byte* base = nullptr;
+    std::size_t mappedSize = 0;
+    std::size_t count = 0;
+#if defined(_WIN32)
+    std::vector<double> fallbackStorage;
+#endif
+
+    void unmap() {
+#if !defined(_WIN32)
+        if (base != nullptr) {
+            munmap(const_cast<std::byte*>(base), mappedSize);
+        }
+#else
+        fallbackStorage.clear();
+#endif
+        base = nullptr;
+        mappedSize = 0;
+        count = 0;
+    }
+
+    bool validate() {
+        ShapeFileHeader header;
+        if (mappedSize < sizeof(header)) return false;
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, shapeFileMagic, sizeof(header.magic)) != 0 ||
+            header.byteOrder != shapeFileByteOrder || header.version != shapeFileVersion) {
+            return false;
+        }
+        // грубая оценка до построения разметки, чтобы count * sizeof не переполнился
+        if (header.count > (mappedSize - sizeof(header)) / (sizeof(ShapeKind) + 3 * sizeof(double))) {
+            return false;
+        }
+        ShapeFileLayout layout(header.count);
+        if (mappedSize < layout.totalSize) return false;
+        // на неизвестном теге switch в aggregateShapeFile молча пропустил бы фигуру
+        const std::byte* tags = base + layout.tagsOffset;
+        for (std::size_t i = 0; i < header.count; ++i) {
+            if (std::to_integer<std::uint8_t>(tags[i]) > static_cast<std::uint8_t>(ShapeKind::Circle)) {
+                return false;
+            }
+        }
+        count = header.count;
+        return true;
+    }
+
+public:
+    ShapeFileView() = default;
+    ShapeFileView(const ShapeFileView&) = delete;
+    ShapeFileView& operator=(const ShapeFileView&) = delete;
+
+    ~ShapeFileView() {
+        unmap();
+    }
+
+    bool open(const std::filesystem::path& path) {
+        unmap();
+#if !defined(_WIN32)
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) return false;
+        struct stat info;
+        if (fstat(descriptor, &info) != 0 || info.st_size == 0) {
+            close(descriptor);
+            return false;
+        }
+        void* memory = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+        if (memory == MAP_FAILED) return false;
+        base = static_cast<const std::byte*>(memory);
+        mappedSize = static_cast<std::size_t>(info.st_size);
+#else
+        // без mmap: один раз читаем файл в выровненный буфер
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) return false;
+        mappedSize = static_cast<std::size_t>(file.tellg());
+        fallbackStorage.resize((mappedSize + sizeof(double) - 1) / sizeof(double));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(fallbackStorage.data()), static_cast<std::streamsize>(mappedSize));
+        base = reinterpret_cast<const std::byte*>(fallbackStorage.data());
+#endif
+        if (!validate()) {
+            unmap();
+            return false;
+        }
+        return true;
+    }
+
+    std::size_t size() const { return count; }
+
+    // у пустого или неоткрытого представления столбцы пусты
+    std::span<const ShapeKind> kinds() const {
+        if (base == nullptr) return {};
+        ShapeFileLayout layout(count);
+        return {reinterpret_cast<const ShapeKind*>(base + layout.tagsOffset), count};
+    }
+
+    std::span<const double> parameter(std::size_t column) const {
+        ShapeFileLayout layout(count);
+        assert(column < layout.parameterOffsets.size());
+        if (base == nullptr || column >= layout.parameterOffsets.size()) return {};
+        return {reinterpret_cast<const double*>(base + layout.parameterOffsets[column]), count};
+    }
+};
+
+struct ShapeTotals {
+    double area = 0.0;
+    double perimeter = 0.0;
+};
+
+inline ShapeTotals aggregateShapeFile(const ShapeFileView& view) {
+    std::span<const ShapeKind> kinds = view.kinds();
+    std::span<const double> first = view.parameter(0);
+    std::span<const double> second = view.parameter(1);
+    std::span<const double> third = view.parameter(2);
+    ShapeTotals totals;
+    for (std::size_t i = 0; i < kinds.size(); ++i) {
+        switch (kinds[i]) {
+        case ShapeKind::Triangle:
+            totals.area += heronArea(first[i], second[i], third[i]);
+            totals.perimeter += first[i] + second[i] + third[i];
+            break;
+        case ShapeKind::Square:
+            totals.area += first[i] * first[i];
+            totals.perimeter += 4.0 * first[i];
+            break;
+        case ShapeKind::Circle:
+            totals.area += std::numbers::pi * first[i] * first[i];
+            totals.perimeter += 2.0 * std::numbers::pi * first[i];
+            break;
+        }
+    }
+    return totals;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Параллельная агрегатная статистика по коллекции фигур
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct StatisticsOptions {
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    // попарное суммирование по блокам фиксированного размера: результат не зависит от числа потоков
+    bool deterministic = false;
+    // гистограмма площадей на [histogramMin, histogramMax); значения вне диапазона попадают в крайние корзины
+    std::size_t histogramBins = 0;
+    double histogramMin = 0.0;
+    double histogramMax = 0.0;
+};
+
+struct ShapeStatistics {
+    std::size_t count = 0;
+    double totalArea = 0.0, meanArea = 0.0, minArea = 0.0, maxArea = 0.0;
+    double totalPerimeter = 0.0, meanPerimeter = 0.0, minPerimeter = 0.0, maxPerimeter = 0.0;
+    std::vector<std::size_t> areaHistogram;
+};
+
+inline double pairwiseSum(std::span<const double> values) {
+    if (values.size() <= 8) {
+        double sum = 0.0;
+        for (double value : values) sum += value;
+        return sum;
+    }
+    std::size_t half = values.size() / 2;
+    return pairwiseSum(values.first(half)) + pairwiseSum(values.subspan(half));
+}
+
+// выровнено по кэш-линии, чтобы соседние потоки не делили одну линию;
+// сама гистограмма живет в общем буфере computeStatistics
+struct alignas(64) ShapeAccumulator {
+    double areaSum = 0.0;
+    double perimeterSum = 0.0;
+    double minArea = std::numeric_limits<double>::infinity();
+    double maxArea = -std::numeric_limits<double>::infinity();
+    double minPerimeter = std::numeric_limits<double>::infinity();
+    double maxPerimeter = -std::numeric_limits<double>::infinity();
+    std::span<std::size_t> histogram;
+};
+
+template<typename Range>
+ShapeStatistics computeStatistics(const Range& shapes, const StatisticsOptions& options = {}) {
+    constexpr std::size_t blockSize = 4096;
+    std::size_t count = std::ranges::size(shapes);
+    std::size_t blocks = (count + blockSize - 1) / blockSize;
+    std::size_t threads = std::max<std::size_t>(1, std::min(options.threads, blocks));
+    // отрицательная, нулевая или NaN ширина корзины сломала бы расчет номера корзины
+    if (options.histogramBins > 0 && !(options.histogramMax > options.histogramMin)) {
+        throw std::invalid_argument("histogramMax must be greater than histogramMin");
+    }
+    double binWidth = options.histogramBins > 0
+        ? (options.histogramMax - options.histogramMin) / static_cast<double>(options.histogramBins)
+        : 0.0;
+
+    std::vector<ShapeAccumulator> accumulators(threads);
+    // гистограммы потоков лежат в одном буфере с шагом, кратным кэш-линии, начиная с ее границы,
+    // иначе отдельные выделения в куче снова делили бы линии между потоками
+    constexpr std::size_t countersPerLine = 64 / sizeof(std::size_t);
+    std::size_t histogramStride = (options.histogramBins + countersPerLine - 1) / countersPerLine * countersPerLine;
+    std::vector<std::size_t> histogramStorage(threads * histogramStride + countersPerLine, 0);
+    void* histogramStart = histogramStorage.data();
+    std::size_t histogramSpace = histogramStorage.size() * sizeof(std::size_t);
+    std::align(64, threads * histogramStride * sizeof(std::size_t), histogramStart, histogramSpace);
+    for (std::size_t thread = 0; thread < threads; ++thread) {
+        accumulators[thread].histogram = {static_cast<std::size_t*>(histogramStart) + thread * histogramStride,
+                                          options.histogramBins};
+    }
+    std::vector<double> blockArea(options.deterministic ? blocks : 0);
+    std::vector<double> blockPerimeter(options.deterministic ? blocks : 0);
+
+    auto worker = [&](std::size_t thread) {
+        ShapeAccumulator& local = accumulators[thread];
+        std::vector<double> areas(blockSize), perimeters(blockSize);
+        // потоку достается непрерывный диапазон блоков
+        std::size_t firstBlock = blocks * thread / threads;
+        std::size_t lastBlock = blocks * (thread + 1) / threads;
+        for (std::size_t block = firstBlock; block < lastBlock; ++block) {
+            std::size_t begin = block * blockSize;
+            std::size_t end = std::min(count, begin + blockSize);
+            for (std::size_t i = begin; i < end; ++i) {
+                const auto& shape = shapes[i];
+                double area = shape->area();
+                double perimeter = shape->perimeter();
+                areas[i - begin] = area;
+                perimeters[i - begin] = perimeter;
+                local.minArea = std::min(local.minArea, area);
+                local.maxArea = std::max(local.maxArea, area);
+                local.minPerimeter = std::min(local.minPerimeter, perimeter);
+                local.maxPerimeter = std::max(local.maxPerimeter, perimeter);
+                // NaN не попадает ни в одну корзину; позиция зажимается до приведения к size_t,
+                // иначе огромная площадь дала бы неопределенное поведение
+                if (options.histogramBins > 0 && !std::isnan(area)) {
+                    double position = std::clamp((area - options.histogramMin) / binWidth,
+                                                 0.0, static_cast<double>(options.histogramBins - 1));
+                    ++local.histogram[static_cast<std::size_t>(position)];
+                }
+            }
+            std::span<const double> blockAreas(areas.data(), end - begin);
+            std::span<const double> blockPerimeters(perimeters.data(), end - begin);
+            if (options.deterministic) {
+                blockArea[block] = pairwiseSum(blockAreas);
+                blockPerimeter[block] = pairwiseSum(blockPerimeters);
+            } else {
+                for (double area : blockAreas) local.areaSum += area;
+                for (double perimeter : blockPerimeters) local.perimeterSum += perimeter;
+            }
+        }
     };
+
+    std::vector<std::thread> pool;
+    for (std::size_t thread = 1; thread < threads; ++thread) {
+        pool.emplace_back(worker, thread);
+    }
+    worker(0);
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+
+    ShapeStatistics result;
+    result.count = count;
+    result.areaHistogram.assign(options.histogramBins, 0);
+    if (count == 0) return result;
+    result.minArea = result.minPerimeter = std::numeric_limits<double>::infinity();
+    result.maxArea = result.maxPerimeter = -std::numeric_limits<double>::infinity();
+    for (const ShapeAccumulator& local : accumulators) {
+        result.totalArea += local.areaSum;
+        result.totalPerimeter += local.perimeterSum;
+        result.minArea = std::min(result.minArea, local.minArea);
+        result.maxArea = std::max(result.maxArea, local.maxArea);
+        result.minPerimeter = std::min(result.minPerimeter, local.minPerimeter);
+        result.maxPerimeter = std::max(result.maxPerimeter, local.maxPerimeter);
+        for (std::size_t bin = 0; bin < local.histogram.size(); ++bin) {
+            result.areaHistogram[bin] += local.histogram[bin];
+        }
+    }
+    if (options.deterministic) {
+        result.totalArea = pairwiseSum(blockArea);
+        result.totalPerimeter = pairwiseSum(blockPerimeter);
+    }
+    result.meanArea = result.totalArea / static_cast<double>(count);
+    result.meanPerimeter = result.totalPerimeter / static_cast<double>(count);
+    return result;
+}
+
+template<typename F>
+long long measureMicroseconds(F&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
 int main() {
     Triangle triangle(3.0, 4.0, 5.0);
     assert(triangle.perimeter() == 12.0);
@@ -97,6 +674,344 @@ int main() {
     }
     shapes.clear();
     
+    // игольчатый треугольник: наивная формула Герона теряет почти все значащие цифры
+    Triangle needle(1.0, 1.0, 1e-12);
+    double needleExact = 0.5 * 1e-12 * std::sqrt(1.0 - 0.25e-24);
+    assert(std::abs(needle.area() - needleExact) <= 1e-12 * needleExact);
+    std::cout << "Needle triangle test passed" << std::endl;
+
+    std::vector<double> side1{3.0, 1.0, 2.0, 7.0, 1.0}, side2{4.0, 1.0, 2.0, 5.0, 1.0},
+                        side3{5.0, 1.0, 2.0, 3.0, 1e-12};
+    std::vector<double> areas(side1.size()), perimeters(side1.size());
+    triangleMetrics(side1, side2, side3, areas, perimeters);
+    for (std::size_t i = 0; i < side1.size(); ++i) {
+        Triangle reference(side1[i], side2[i], side3[i]);
+        assert(std::abs(areas[i] - reference.area()) <= 1e-12 * reference.area());
+        assert(perimeters[i] == reference.perimeter());
+    }
+    std::vector<double> lengths{5.0, 0.5, 3.0};
+    squareMetrics(lengths, areas, perimeters);
+    assert(areas[0] == 25.0 && perimeters[0] == 20.0);
+    circleMetrics(lengths, areas, perimeters);
+    assert(std::abs(perimeters[2] - 18.8496) <= 1e-3);
+    assert(std::abs(areas[2] - 28.2743) <= 1e-3);
+    std::cout << "Batch kernels test passed" << std::endl;
+
+    // бенчмарк: виртуальный вызов на каждый объект против пакетных ядер
+    const std::size_t count = 1'000'000;
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> sideRange(1.0, 2.0);
+    std::vector<double> batchSide1(count), batchSide2(count), batchSide3(count), radii(count);
+    std::vector<std::unique_ptr<Shape>> objects;
+    objects.reserve(3 * count);
+    for (std::size_t i = 0; i < count; ++i) {
+        batchSide1[i] = sideRange(generator);
+        batchSide2[i] = sideRange(generator);
+        batchSide3[i] = sideRange(generator);
+        radii[i] = sideRange(generator);
+        objects.push_back(std::make_unique<Triangle>(batchSide1[i], batchSide2[i], batchSide3[i]));
+        objects.push_back(std::make_unique<Square>(radii[i]));
+        objects.push_back(std::make_unique<Circle>(radii[i]));
+    }
+
+    double virtualSum = 0.0;
+    long long virtualTime = measureMicroseconds([&] {
+        for (const auto& object : objects) {
+            virtualSum += object->area() + object->perimeter();
+        }
+    });
+
+    std::vector<double> batchArea(count), batchPerimeter(count);
+    double batchSum = 0.0;
+    long long batchTime = measureMicroseconds([&] {
+        triangleMetrics(batchSide1, batchSide2, batchSide3, batchArea, batchPerimeter);
+        for (std::size_t i = 0; i < count; ++i) batchSum += batchArea[i] + batchPerimeter[i];
+        squareMetrics(radii, batchArea, batchPerimeter);
+        for (std::size_t i = 0; i < count; ++i) batchSum += batchArea[i] + batchPerimeter[i];
+        circleMetrics(radii, batchArea, batchPerimeter);
+        for (std::size_t i = 0; i < count; ++i) batchSum += batchArea[i] + batchPerimeter[i];
+    });
+    assert(std::abs(virtualSum - batchSum) <= 1e-9 * virtualSum);
+    std::cout << "Virtual path: " << virtualTime << " us, batch kernels: " << batchTime
+              << " us for " << 3 * count << " shapes" << std::endl;
+
+    {
+        ShapeArena arena(256);
+        std::vector<ArenaPtr<Shape>> arenaShapes;
+        std::size_t firstRoundReserved = 0;
+        for (int round = 0; round < 2; ++round) {
+            for (int i = 0; i < 30; ++i) {
+                arenaShapes.push_back(arena.create<Triangle>(3.0, 4.0, 5.0));
+                arenaShapes.push_back(arena.create<Square>(5.0));
+                arenaShapes.push_back(arena.create<Circle>(3.0));
+            }
+            for (std::size_t i = 0; i < arenaShapes.size(); i += 3) {
+                assert(arenaShapes[i]->area() == 6.0);
+                assert(arenaShapes[i + 1]->perimeter() == 20.0);
+                assert(std::abs(arenaShapes[i + 2]->area() - 28.2743) <= 1e-3);
+            }
+            if (round == 0) firstRoundReserved = arena.reservedBytes();
+            arenaShapes.clear();
+            arena.reset();
+        }
+        // второй раунд переиспользует блоки первого
+        assert(arena.reservedBytes() == firstRoundReserved);
+
+        struct alignas(128) OverAligned {
+            double value;
+        };
+        for (int i = 0; i < 4; ++i) {
+            ArenaPtr<OverAligned> overAligned = arena.create<OverAligned>(OverAligned{1.0});
+            assert(reinterpret_cast<std::uintptr_t>(overAligned.get()) % 128 == 0);
+        }
+        bool oversizedThrows = false;
+        try {
+            arena.create<std::array<double, 64>>();
+        } catch (const std::bad_alloc&) {
+            oversizedThrows = true;
+        }
+        assert(oversizedThrows);
+        arena.reset();
+        PmrShapeArena pmrArena;
+        ArenaPtr<Shape> pmrShape = pmrArena.create<Square>(2.0);
+        assert(pmrShape->area() == 4.0);
+        pmrShape.reset();
+        pmrArena.reset();
+    }
+    std::cout << "Shape arena test passed" << std::endl;
+
+    // бенчмарк: цикл "создать - пройти - освободить" для new/delete, make_unique и арен
+    const int rounds = 5;
+    auto runCycle = [&](auto&& makeShape, auto& storage, auto&& releaseAll) {
+        double sum = 0.0;
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < count; ++i) {
+                storage.push_back(makeShape(0, radii[i]));
+                storage.push_back(makeShape(1, radii[i]));
+                storage.push_back(makeShape(2, radii[i]));
+            }
+            for (const auto& shape : storage) {
+                sum += shape->area();
+            }
+            releaseAll();
+        }
+        return sum;
+    };
+
+    std::vector<Shape*> rawShapes;
+    rawShapes.reserve(3 * count);
+    long long newDeleteTime = measureMicroseconds([&] {
+        runCycle([](int kind, double size) -> Shape* {
+            if (kind == 0) return new Triangle(size, size, size);
+            if (kind == 1) return new Square(size);
+            return new Circle(size);
+        }, rawShapes, [&] {
+            for (Shape* shape : rawShapes) delete shape;
+            rawShapes.clear();
+        });
+    });
+
+    std::vector<std::unique_ptr<Shape>> uniqueShapes;
+    uniqueShapes.reserve(3 * count);
+    long long makeUniqueTime = measureMicroseconds([&] {
+        runCycle([](int kind, double size) -> std::unique_ptr<Shape> {
+            if (kind == 0) return std::make_unique<Triangle>(size, size, size);
+            if (kind == 1) return std::make_unique<Square>(size);
+            return std::make_unique<Circle>(size);
+        }, uniqueShapes, [&] { uniqueShapes.clear(); });
+    });
+
+    ShapeArena benchArena(1 << 20);
+    std::vector<ArenaPtr<Shape>> arenaShapes;
+    arenaShapes.reserve(3 * count);
+    long long arenaTime = measureMicroseconds([&] {
+        runCycle([&](int kind, double size) -> ArenaPtr<Shape> {
+            if (kind == 0) return benchArena.create<Triangle>(size, size, size);
+            if (kind == 1) return benchArena.create<Square>(size);
+            return benchArena.create<Circle>(size);
+        }, arenaShapes, [&] {
+            arenaShapes.clear();
+            benchArena.reset();
+        });
+    });
+
+    PmrShapeArena benchPmrArena(1 << 20);
+    long long pmrArenaTime = measureMicroseconds([&] {
+        runCycle([&](int kind, double size) -> ArenaPtr<Shape> {
+            if (kind == 0) return benchPmrArena.create<Triangle>(size, size, size);
+            if (kind == 1) return benchPmrArena.create<Square>(size);
+            return benchPmrArena.create<Circle>(size);
+        }, arenaShapes, [&] {
+            arenaShapes.clear();
+            benchPmrArena.reset();
+        });
+    });
+    std::cout << "Allocate/iterate/free x" << rounds << ": new/delete " << newDeleteTime
+              << " us, make_unique " << makeUniqueTime << " us, ShapeArena " << arenaTime
+              << " us, PmrShapeArena " << pmrArenaTime << " us" << std::endl;
+
+    std::filesystem::path shapeFilePath = std::filesystem::temp_directory_path() / "3_6_shapes.bin";
+    {
+        std::vector<std::unique_ptr<Shape>> saved;
+        saved.push_back(std::make_unique<Triangle>(3.0, 4.0, 5.0));
+        saved.push_back(std::make_unique<Square>(5.0));
+        saved.push_back(std::make_unique<Circle>(3.0));
+        bool written = writeShapeFile(shapeFilePath, saved);
+        assert(written);
+
+        ShapeFileView view;
+        assert(view.kinds().empty() && view.parameter(0).empty());
+        bool opened = view.open(shapeFilePath);
+        assert(opened);
+        assert(view.size() == 3);
+        assert(view.kinds()[0] == ShapeKind::Triangle && view.kinds()[2] == ShapeKind::Circle);
+        assert(view.parameter(2)[0] == 5.0 && view.parameter(0)[1] == 5.0);
+        assert(reinterpret_cast<std::uintptr_t>(view.parameter(1).data()) % alignof(double) == 0);
+        ShapeTotals totals = aggregateShapeFile(view);
+        assert(std::abs(totals.area - (6.0 + 25.0 + 9.0 * std::numbers::pi)) <= 1e-9);
+        assert(std::abs(totals.perimeter - (12.0 + 20.0 + 6.0 * std::numbers::pi)) <= 1e-9);
+
+        // файл с испорченным заголовком или тегом должен отвергаться при открытии
+        auto patchShapeFile = [&](std::size_t position, const void* bytes, std::size_t length) {
+            writeShapeFile(shapeFilePath, saved);
+            std::fstream file(shapeFilePath, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(position));
+            file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(length));
+        };
+        std::uint64_t hugeCount = std::numeric_limits<std::uint64_t>::max() / sizeof(double) + 1;
+        patchShapeFile(offsetof(ShapeFileHeader, count), &hugeCount, sizeof(hugeCount));
+        opened = view.open(shapeFilePath);
+        assert(!opened);
+        std::uint32_t swappedByteOrder = 0x04030201;
+        patchShapeFile(offsetof(ShapeFileHeader, byteOrder), &swappedByteOrder, sizeof(swappedByteOrder));
+        opened = view.open(shapeFilePath);
+        assert(!opened);
+        std::uint8_t badTag = 7;
+        patchShapeFile(ShapeFileLayout(saved.size()).tagsOffset + 1, &badTag, sizeof(badTag));
+        opened = view.open(shapeFilePath);
+        assert(!opened);
+
+        std::ofstream(shapeFilePath, std::ios::binary) << "not a shape file";
+        opened = view.open(shapeFilePath);
+        assert(!opened);
+    }
+    std::cout << "Binary serialization test passed" << std::endl;
+
+    // бенчмарк: загрузка текстом с созданием объектов против отображения бинарного файла
+    std::filesystem::path textFilePath = std::filesystem::temp_directory_path() / "3_6_shapes.txt";
+    {
+        std::ofstream text(textFilePath);
+        text.precision(17);
+        for (const auto& object : objects) {
+            std::array<double, 3> parameters = object->parameters();
+            text << static_cast<int>(object->kind()) << ' ' << parameters[0] << ' '
+                 << parameters[1] << ' ' << parameters[2] << '\n';
+        }
+    }
+    bool benchWritten = writeShapeFile(shapeFilePath, objects);
+    assert(benchWritten);
+
+    std::vector<std::unique_ptr<Shape>> parsed;
+    long long textLoadTime = measureMicroseconds([&] {
+        std::ifstream text(textFilePath);
+        int kind;
+        double first, second, third;
+        while (text >> kind >> first >> second >> third) {
+            if (kind == 0) parsed.push_back(std::make_unique<Triangle>(first, second, third));
+            else if (kind == 1) parsed.push_back(std::make_unique<Square>(first));
+            else parsed.push_back(std::make_unique<Circle>(first));
+        }
+    });
+    assert(parsed.size() == objects.size());
+
+    ShapeFileView mapped;
+    bool benchOpened = false;
+    long long binaryLoadTime = measureMicroseconds([&] { benchOpened = mapped.open(shapeFilePath); });
+    assert(benchOpened);
+
+    ShapeTotals objectTotals;
+    long long objectAggregateTime = measureMicroseconds([&] {
+        for (const auto& object : parsed) {
+            objectTotals.area += object->area();
+            objectTotals.perimeter += object->perimeter();
+        }
+    });
+    ShapeTotals mappedTotals;
+    long long mappedAggregateTime = measureMicroseconds([&] { mappedTotals = aggregateShapeFile(mapped); });
+    assert(std::abs(objectTotals.area - mappedTotals.area) <= 1e-6 * mappedTotals.area);
+    std::cout << "Load: text " << textLoadTime << " us, mapped binary " << binaryLoadTime
+              << " us; aggregate: objects " << objectAggregateTime << " us, mapped columns "
+              << mappedAggregateTime << " us" << std::endl;
+    parsed.clear();
+    std::filesystem::remove(textFilePath);
+    std::filesystem::remove(shapeFilePath);
+
+    {
+        std::vector<std::unique_ptr<Shape>> sample;
+        sample.push_back(std::make_unique<Triangle>(3.0, 4.0, 5.0));
+        sample.push_back(std::make_unique<Square>(5.0));
+        sample.push_back(std::make_unique<Circle>(3.0));
+        StatisticsOptions options;
+        options.threads = 4;
+        options.histogramBins = 3;
+        options.histogramMin = 0.0;
+        options.histogramMax = 30.0;
+        ShapeStatistics statistics = computeStatistics(sample, options);
+        assert(statistics.count == 3);
+        assert(statistics.minArea == 6.0 && statistics.maxArea == Circle(3.0).area());
+        assert(statistics.minPerimeter == 12.0 && statistics.maxPerimeter == 20.0);
+        assert(std::abs(statistics.meanArea - (31.0 + 9.0 * std::numbers::pi) / 3.0) <= 1e-12);
+        assert((statistics.areaHistogram == std::vector<std::size_t>{1, 0, 2}));
+
+        sample.push_back(std::make_unique<Square>(1e300));
+        sample.push_back(std::make_unique<Circle>(std::numeric_limits<double>::quiet_NaN()));
+        statistics = computeStatistics(sample, options);
+        assert((statistics.areaHistogram == std::vector<std::size_t>{1, 0, 3}));
+        options.histogramMax = options.histogramMin;
+        bool emptyRangeThrows = false;
+        try {
+            computeStatistics(sample, options);
+        } catch (const std::invalid_argument&) {
+            emptyRangeThrows = true;
+        }
+        assert(emptyRangeThrows);
+
+        std::vector<std::unique_ptr<Shape>> none;
+        assert(computeStatistics(none).count == 0);
+
+        StatisticsOptions single, several;
+        single.threads = 1;
+        several.threads = 7;
+        single.deterministic = several.deterministic = true;
+        ShapeStatistics singleResult = computeStatistics(objects, single);
+        ShapeStatistics severalResult = computeStatistics(objects, several);
+        assert(singleResult.totalArea == severalResult.totalArea);
+        assert(singleResult.totalPerimeter == severalResult.totalPerimeter);
+        assert(singleResult.maxArea == severalResult.maxArea);
+    }
+    std::cout << "Statistics test passed" << std::endl;
+
+    // масштабирование от 1 потока до всех ядер; детерминированный режим должен давать
+    // побитово одинаковую сумму при любом числе потоков
+    std::size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    double referenceTotal = 0.0;
+    for (std::size_t threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+        StatisticsOptions options;
+        options.threads = threads;
+        options.histogramBins = 16;
+        options.histogramMax = 16.0;
+        ShapeStatistics fast, exact;
+        long long fastTime = measureMicroseconds([&] { fast = computeStatistics(objects, options); });
+        options.deterministic = true;
+        long long exactTime = measureMicroseconds([&] { exact = computeStatistics(objects, options); });
+        if (threads == 1) referenceTotal = exact.totalArea;
+        assert(exact.totalArea == referenceTotal);
+        assert(std::abs(fast.totalArea - exact.totalArea) <= 1e-9 * exact.totalArea);
+        std::cout << "Statistics with " << threads << " threads: " << fastTime
+                  << " us, deterministic " << exactTime << " us" << std::endl;
+        if (threads == maxThreads) break;
+    }
+
     std::cout << "All tests are passed successfully" << std::endl;
     
     return 0;
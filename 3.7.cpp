@@ -5,41 +5,656 @@
 #include <utility>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <tuple>
+#include <thread>
+#include <fstream>
+#include <cstdlib>
+#include <concepts>
+#include <new>
+#include <limits>
+#include <stdexcept>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <chrono>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <optional>
+#include <condition_variable>
+#ifdef WITH_PARALLEL_STL
+#include <execution>
+#include <numeric>
+#endif
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Политики роста емкости
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct DoublingGrowth {
+    static std::size_t grow(std::size_t capacity) {
+        return capacity == 0 ? 1 : capacity * 2;
+    }
+};
+
+struct GoldenGrowth {
+    static std::size_t grow(std::size_t capacity) {
+        return capacity < 2 ? capacity + 1 : capacity + capacity / 2;
+    }
+};
+
+template<std::size_t Increment>
+struct FixedIncrementGrowth {
+    static_assert(Increment > 0);
+
+    static std::size_t grow(std::size_t capacity) {
+        return capacity + Increment;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Распределитель на malloc с reallocate: realloc для обычных блоков, а большие блоки
+// (от mapThreshold байт) живут в mmap и растут через mremap, где ядро переносит страницы
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct ReallocationStats {
+    static inline std::size_t copiedBytes = 0;
+    static inline std::size_t remappedBytes = 0;
+};
+
+template<typename T>
+class MallocAllocator {
+public:
+    using value_type = T;
+
+    static constexpr std::size_t mapThreshold = 32 * 1024 * 1024;
+
+    MallocAllocator() = default;
+
+    template<typename U>
+    MallocAllocator(const MallocAllocator<U>&) {}
+
+    T* allocate(std::size_t count) {
+        // как и std::allocator: размер, не влезающий в size_t, не должен молча обрезаться
+        if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+        std::size_t bytes = count * sizeof(T);
+#if defined(__linux__)
+        if (bytes >= mapThreshold) {
+            void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED) throw std::bad_alloc();
+            return static_cast<T*>(memory);
+        }
+#endif
+        void* memory = std::malloc(bytes);
+        if (memory == nullptr) throw std::bad_alloc();
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* pointer, std::size_t count) {
+#if defined(__linux__)
+        if (count * sizeof(T) >= mapThreshold) {
+            munmap(pointer, count * sizeof(T));
+            return;
+        }
+#endif
+        std::free(pointer);
+    }
+
+    // Только для тривиально копируемых T: содержимое переносится побайтно
+    T* reallocate(T* pointer, std::size_t old_count, std::size_t new_count) {
+        if (new_count > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+        std::size_t old_bytes = old_count * sizeof(T);
+        std::size_t new_bytes = new_count * sizeof(T);
+        if (pointer == nullptr) return allocate(new_count);
+#if defined(__linux__)
+        bool old_mapped = old_bytes >= mapThreshold;
+        bool new_mapped = new_bytes >= mapThreshold;
+        if (old_mapped && new_mapped) {
+            void* memory = mremap(pointer, old_bytes, new_bytes, MREMAP_MAYMOVE);
+            if (memory == MAP_FAILED) throw std::bad_alloc();
+            ReallocationStats::remappedBytes += std::min(old_bytes, new_bytes);
+            return static_cast<T*>(memory);
+        }
+        if (old_mapped != new_mapped) {
+            T* new_pointer = allocate(new_count);
+            std::memcpy(new_pointer, pointer, std::min(old_bytes, new_bytes));
+            ReallocationStats::copiedBytes += std::min(old_bytes, new_bytes);
+            deallocate(pointer, old_count);
+            return new_pointer;
+        }
+#endif
+        void* memory = std::realloc(pointer, new_bytes);
+        if (memory == nullptr) throw std::bad_alloc();
+        if (memory != pointer) {
+            ReallocationStats::copiedBytes += std::min(old_bytes, new_bytes);
+        }
+        return static_cast<T*>(memory);
+    }
+
+    friend bool operator==(const MallocAllocator&, const MallocAllocator&) {
+        return true;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Распределитель для больших буферов: блоки от hugeThreshold байт берутся из mmap
+// с выравниванием на 2 МБ и помечаются MADV_HUGEPAGE, по желанию привязываются к узлу
+// NUMA. Vector заполняет новые элементы через fill: несколькими потоками, и первое касание
+// каждого потока сразу размещает его страницы. Если что-то из этого недоступно, распределитель
+// работает как обычный; неудачные привязки к узлу считаются в HugePageStats
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct HugePageStats {
+    static inline std::atomic<std::size_t> numaBindFailures{0};
+};
+
+template<typename T>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+    static constexpr std::size_t hugePageSize = 2 * 1024 * 1024;
+    static constexpr std::size_t hugeThreshold = 4 * 1024 * 1024;
+
+    int numaNode = -1;
+    unsigned firstTouchThreads = 0;
+    bool hugePages = true;
+
+    HugePageAllocator() = default;
+
+    explicit HugePageAllocator(int node, unsigned touchThreads = 0, bool useHugePages = true)
+        : numaNode(node), firstTouchThreads(touchThreads), hugePages(useHugePages) {}
+
+    template<typename U>
+    HugePageAllocator(const HugePageAllocator<U>& other)
+        : numaNode(other.numaNode), firstTouchThreads(other.firstTouchThreads), hugePages(other.hugePages) {}
+
+    static std::size_t mappedLength(std::size_t bytes) {
+        return (bytes + hugePageSize - 1) / hugePageSize * hugePageSize;
+    }
+
+    T* allocate(std::size_t count) {
+        // отображение добавляет до двух больших страниц на выравнивание
+        if (count > (std::numeric_limits<std::size_t>::max() - 2 * hugePageSize) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        std::size_t bytes = count * sizeof(T);
+#if defined(__linux__)
+        if (bytes >= hugeThreshold) {
+            std::size_t length = mappedLength(bytes);
+            // берем на страницу больше и обрезаем края, чтобы начало легло на границу 2 МБ
+            void* raw = mmap(nullptr, length + hugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) throw std::bad_alloc();
+            std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw);
+            std::uintptr_t aligned = (start + hugePageSize - 1) & ~(hugePageSize - 1);
+            if (aligned > start) {
+                munmap(raw, aligned - start);
+            }
+            std::size_t tail = start + length + hugePageSize - (aligned + length);
+            if (tail > 0) {
+                munmap(reinterpret_cast<void*>(aligned + length), tail);
+            }
+            void* memory = reinterpret_cast<void*>(aligned);
+            if (hugePages) {
+                madvise(memory, length, MADV_HUGEPAGE);
+            }
+            if (numaNode >= 0) {
+                bool bound = false;
+                if (numaNode < static_cast<int>(8 * sizeof(unsigned long))) {
+                    unsigned long mask = 1UL << numaNode;
+                    const int bindPolicy = 2; // MPOL_BIND
+                    bound = syscall(SYS_mbind, memory, length, bindPolicy, &mask, 8 * sizeof(mask), 0) == 0;
+                }
+                if (!bound) {
+                    HugePageStats::numaBindFailures.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            return static_cast<T*>(memory);
+        }
+#endif
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T* pointer, std::size_t count) {
+#if defined(__linux__)
+        if (count * sizeof(T) >= hugeThreshold) {
+            munmap(pointer, mappedLength(count * sizeof(T)));
+            return;
+        }
+#endif
+        std::allocator<T>().deallocate(pointer, count);
+    }
+
+    friend bool operator==(const HugePageAllocator& lhs, const HugePageAllocator& rhs) {
+        return lhs.numaNode == rhs.numaNode && lhs.firstTouchThreads == rhs.firstTouchThreads &&
+               lhs.hugePages == rhs.hugePages;
+    }
+
+    // каждый поток заполняет свою часть и этим первым касанием размещает ее страницы
+    void fill(T* first, std::size_t count, const T& value) const {
+        if (firstTouchThreads == 0 || count * sizeof(T) < hugeThreshold) {
+            std::fill_n(first, count, value);
+            return;
+        }
+        std::vector<std::thread> threads;
+        for (unsigned thread = 0; thread < firstTouchThreads; ++thread) {
+            threads.emplace_back([=, this, &value] {
+                std::size_t begin = count * thread / firstTouchThreads;
+                std::size_t end = count * (thread + 1) / firstTouchThreads;
+                std::fill(first + begin, first + end, value);
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Телеметрия выделений. NoTelemetry (по умолчанию) состоит из пустых inline-функций
+// и полностью исчезает при компиляции; CountingTelemetry<"тег"> собирает счетчики
+// по своему тегу и в общую сумму
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct NoTelemetry {
+    static void on_reserve() {}
+    static void on_reallocate(std::size_t, std::size_t, std::size_t) {}
+    static void on_destroy(std::size_t, std::size_t) {}
+};
+
+struct AllocationCounters {
+    std::atomic<std::size_t> reserveCalls{0};
+    std::atomic<std::size_t> reallocations{0};
+    std::atomic<std::size_t> bytesCopied{0};
+    std::atomic<std::size_t> peakCapacityBytes{0};
+    std::atomic<std::size_t> liveCapacityBytes{0};
+    std::atomic<std::size_t> peakLiveCapacityBytes{0};
+    std::atomic<std::size_t> destroyedVectors{0};
+    std::atomic<std::size_t> slackBytesAtDestruction{0};
+
+    static void raise(std::atomic<std::size_t>& peak, std::size_t value) {
+        std::size_t current = peak.load(std::memory_order_relaxed);
+        while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
+    void reallocated(std::size_t old_bytes, std::size_t new_bytes, std::size_t copied) {
+        reallocations.fetch_add(1, std::memory_order_relaxed);
+        bytesCopied.fetch_add(copied, std::memory_order_relaxed);
+        raise(peakCapacityBytes, new_bytes);
+        std::size_t live = liveCapacityBytes.fetch_add(new_bytes - old_bytes, std::memory_order_relaxed) + new_bytes - old_bytes;
+        raise(peakLiveCapacityBytes, live);
+    }
+
+    // векторы без памяти в куче (пустые и опустошенные перемещением) не учитываются
+    void destroyed(std::size_t size_bytes, std::size_t capacity_bytes) {
+        if (capacity_bytes == 0) return;
+        destroyedVectors.fetch_add(1, std::memory_order_relaxed);
+        liveCapacityBytes.fetch_sub(capacity_bytes, std::memory_order_relaxed);
+        slackBytesAtDestruction.fetch_add(capacity_bytes - std::min(size_bytes, capacity_bytes), std::memory_order_relaxed);
+    }
+};
+
+class AllocationTelemetry {
+private:
+    static std::mutex& registryMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::deque<std::pair<std::string, AllocationCounters>>& registry() {
+        static std::deque<std::pair<std::string, AllocationCounters>> tags;
+        return tags;
+    }
+
+    static void print(std::ostream& out, const std::string& name, const AllocationCounters& counters) {
+        out << name << ": reserve calls " << counters.reserveCalls
+            << ", reallocations " << counters.reallocations
+            << ", bytes copied " << counters.bytesCopied
+            << ", peak capacity " << counters.peakCapacityBytes
+            << " B, live capacity " << counters.liveCapacityBytes
+            << " B (peak " << counters.peakLiveCapacityBytes
+            << " B), slack at destruction " << counters.slackBytesAtDestruction
+            << " B over " << counters.destroyedVectors << " vectors\n";
+    }
+
+public:
+    static AllocationCounters& global() {
+        static AllocationCounters counters;
+        return counters;
+    }
+
+    static AllocationCounters& tag(const char* name) {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        for (auto& [tagName, counters] : registry()) {
+            if (tagName == name) return counters;
+        }
+        return registry().emplace_back(std::piecewise_construct, std::forward_as_tuple(name), std::tuple<>()).second;
+    }
+
+    static void dump(std::ostream& out) {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        print(out, "total", global());
+        for (const auto& [tagName, counters] : registry()) {
+            print(out, tagName, counters);
+        }
+    }
+};
+
+template<std::size_t N>
+struct TelemetryTag {
+    char name[N];
+
+    constexpr TelemetryTag(const char (&text)[N]) {
+        std::copy_n(text, N, name);
+    }
+};
+
+template<TelemetryTag Tag>
+struct CountingTelemetry {
+    static AllocationCounters& counters() {
+        static AllocationCounters& tagged = AllocationTelemetry::tag(Tag.name);
+        return tagged;
+    }
+
+    static void on_reserve() {
+        counters().reserveCalls.fetch_add(1, std::memory_order_relaxed);
+        AllocationTelemetry::global().reserveCalls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void on_reallocate(std::size_t old_bytes, std::size_t new_bytes, std::size_t copied) {
+        counters().reallocated(old_bytes, new_bytes, copied);
+        AllocationTelemetry::global().reallocated(old_bytes, new_bytes, copied);
+    }
+
+    static void on_destroy(std::size_t size_bytes, std::size_t capacity_bytes) {
+        counters().destroyed(size_bytes, capacity_bytes);
+        AllocationTelemetry::global().destroyed(size_bytes, capacity_bytes);
+    }
+};
+
+// InlineCapacity > 0 включает малый буфер: первые InlineCapacity элементов хранятся
+// внутри самого объекта, и только при переполнении данные уходят в кучу
+template<typename T, typename Allocator = std::allocator<T>, typename Growth = DoublingGrowth,
+         std::size_t InlineCapacity = 0, typename Telemetry = NoTelemetry>
 class Vector {
 private:
-    int* m_data = nullptr;
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    struct NoInlineBuffer {
+        T* data() { return nullptr; }
+    };
+
+    struct InlineBuffer {
+        alignas(T) std::byte bytes[sizeof(T) * (InlineCapacity > 0 ? InlineCapacity : 1)];
+
+        T* data() { return reinterpret_cast<T*>(bytes); }
+    };
+
+    // новые элементы заполняет распределитель, если умеет (HugePageAllocator делает это параллельно)
+    static constexpr bool can_fill = std::is_trivially_copyable_v<T> &&
+        requires(Allocator& allocator, T* pointer, std::size_t count, const T& value) {
+            allocator.fill(pointer, count, value);
+        };
+
+    // рост на месте возможен, если элементы можно переносить побайтно, а распределитель умеет reallocate
+    static constexpr bool can_reallocate = std::is_trivially_copyable_v<T> &&
+        requires(Allocator& allocator, T* pointer, std::size_t count) {
+            { allocator.reallocate(pointer, count, count) } -> std::same_as<T*>;
+        };
+
+    [[no_unique_address]] std::conditional_t<InlineCapacity == 0, NoInlineBuffer, InlineBuffer> m_inline;
+    T* m_data = m_inline.data();
     std::size_t m_size = 0;
-    std::size_t m_capacity = 0;
+    std::size_t m_capacity = InlineCapacity;
+    [[no_unique_address]] Allocator m_allocator;
 
-public:
-    Vector() = default;
-    
-    Vector(std::size_t initial_capacity) : m_capacity(initial_capacity) {
-        if (m_capacity > 0) {
-            m_data = new int[m_capacity];
+    bool is_inline() const {
+        if constexpr (InlineCapacity == 0) {
+            return false;
+        } else {
+            return m_data == const_cast<Vector*>(this)->m_inline.data();
         }
     }
-    
-    Vector(std::initializer_list<int> list) : m_size(list.size()), m_capacity(list.size()) {
-        if (m_capacity > 0) {
-            m_data = new int[m_capacity];
-            std::copy(list.begin(), list.end(), m_data);
+
+    // память в куче; малый буфер в телеметрию не входит
+    std::size_t heap_bytes() const {
+        return m_data && !is_inline() ? m_capacity * sizeof(T) : 0;
+    }
+
+    // забирает содержимое other (указатель на кучу или элементы малого буфера);
+    // сам вектор должен быть пуст и без памяти в куче, other остается пустым
+    void take(Vector& other) {
+        if (other.is_inline()) {
+            relocate(other.m_data, other.m_size, m_inline.data());
+            m_data = m_inline.data();
+            m_capacity = InlineCapacity;
+        } else {
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            other.m_data = other.m_inline.data();
+            other.m_capacity = InlineCapacity;
+        }
+        m_size = std::exchange(other.m_size, 0);
+    }
+
+    // тривиально копируемые элементы переносятся memcpy, остальные перемещаются
+    // (или копируются, если перемещение может бросить исключение)
+    void relocate(T* from, std::size_t count, T* to) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+            }
+        } else {
+            std::size_t constructed = 0;
+            try {
+                for (; constructed < count; ++constructed) {
+                    AllocatorTraits::construct(m_allocator, to + constructed, std::move_if_noexcept(from[constructed]));
+                }
+            } catch (...) {
+                destroy(to, constructed);
+                throw;
+            }
+            destroy(from, count);
         }
     }
-    
 
-    Vector(const Vector& other) : m_size(other.m_size), m_capacity(other.m_capacity) {
-        if (m_capacity > 0) {
-            m_data = new int[m_capacity];
-            std::copy(other.m_data, other.m_data + other.m_size, m_data);
+    void destroy(T* first, std::size_t count) {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (std::size_t i = 0; i < count; ++i) {
+                AllocatorTraits::destroy(m_allocator, first + i);
+            }
         }
     }
+
+    void deallocate() {
+        if (m_data && !is_inline()) {
+            AllocatorTraits::deallocate(m_allocator, m_data, m_capacity);
+        }
+    }
+
+    void reallocate(std::size_t new_capacity) {
+        std::size_t old_bytes = heap_bytes();
+        std::size_t copied = reallocate_storage(new_capacity);
+        Telemetry::on_reallocate(old_bytes, heap_bytes(), copied);
+    }
+
+    // возвращает, сколько байт элементов пришлось перенести
+    std::size_t reallocate_storage(std::size_t new_capacity) {
+        if constexpr (InlineCapacity > 0) {
+            if (new_capacity <= InlineCapacity) {
+                if (is_inline()) return 0;
+                T* heap_array = m_data;
+                std::size_t heap_capacity = m_capacity;
+                relocate(heap_array, m_size, m_inline.data());
+                AllocatorTraits::deallocate(m_allocator, heap_array, heap_capacity);
+                m_data = m_inline.data();
+                m_capacity = InlineCapacity;
+                return m_size * sizeof(T);
+            }
+        }
+        if constexpr (can_reallocate) {
+            if (m_data && !is_inline() && new_capacity > 0) {
+                // блок, выросший на месте, ничего не копировал
+                T* old_data = std::exchange(m_data, m_allocator.reallocate(m_data, m_capacity, new_capacity));
+                m_capacity = new_capacity;
+                return m_data == old_data ? 0 : m_size * sizeof(T);
+            }
+        }
+        T* new_array = new_capacity > 0 ? AllocatorTraits::allocate(m_allocator, new_capacity) : nullptr;
+        try {
+            relocate(m_data, m_size, new_array);
+        } catch (...) {
+            AllocatorTraits::deallocate(m_allocator, new_array, new_capacity);
+            throw;
+        }
+        deallocate();
+        m_data = new_array;
+        m_capacity = new_capacity;
+        return m_size * sizeof(T);
+    }
+
+    std::size_t next_capacity() const {
+        return std::max(Growth::grow(m_capacity), m_capacity + 1);
+    }
+
+    struct copy_tag {};
+
+    Vector(copy_tag, const T* source, std::size_t count, std::size_t capacity = 0,
+           const Allocator& allocator = Allocator())
+        : m_allocator(allocator) {
+        reserve(std::max(count, capacity));
+        // деструктор недостроенного объекта не вызовется: откатываемся сами
+        try {
+            for (; m_size < count; ++m_size) {
+                AllocatorTraits::construct(m_allocator, m_data + m_size, source[m_size]);
+            }
+        } catch (...) {
+            Telemetry::on_destroy(m_size * sizeof(T), heap_bytes());
+            destroy(m_data, m_size);
+            deallocate();
+            throw;
+        }
+    }
+
+    // диапазон указывает внутрь собственного буфера: перед изменением его нужно скопировать
+    template<typename Range>
+    static constexpr bool contiguous_of_T = std::ranges::contiguous_range<Range> &&
+        std::is_same_v<std::remove_cv_t<std::ranges::range_value_t<Range>>, T>;
+
+    template<typename Range>
+    bool aliases(Range& range) const {
+        const T* first = std::ranges::data(range);
+        return m_size > 0 && std::less_equal<const T*>()(m_data, first) && std::less<const T*>()(first, m_data + m_size);
+    }
+
+    void grow_to(std::size_t required) {
+        if (required > m_capacity) {
+            reallocate(std::max(required, next_capacity()));
+        }
+    }
+
+    // строит count элементов из range за концом; для тривиально копируемых подряд лежащих данных — memcpy
+    template<typename Range>
+    void construct_at_end(Range& range, std::size_t count) {
+        if constexpr (std::is_trivially_copyable_v<T> && contiguous_of_T<Range>) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(m_data + m_size), std::ranges::data(range), count * sizeof(T));
+            }
+            m_size += count;
+        } else {
+            for (auto&& value : range) {
+                AllocatorTraits::construct(m_allocator, m_data + m_size, std::forward<decltype(value)>(value));
+                ++m_size;
+            }
+        }
+    }
+
+    // вставка с переездом: новые элементы строятся сразу в новом буфере, затем переносятся соседи
+    template<typename Range>
+    void insert_reallocating(std::size_t position, Range& range, std::size_t count) {
+        std::size_t new_capacity = std::max(m_size + count, next_capacity());
+        std::size_t old_bytes = heap_bytes();
+        T* new_array = AllocatorTraits::allocate(m_allocator, new_capacity);
+        std::size_t constructed = 0;
+        try {
+            for (auto&& value : range) {
+                AllocatorTraits::construct(m_allocator, new_array + position + constructed, std::forward<decltype(value)>(value));
+                ++constructed;
+            }
+        } catch (...) {
+            destroy(new_array + position, constructed);
+            AllocatorTraits::deallocate(m_allocator, new_array, new_capacity);
+            throw;
+        }
+        try {
+            relocate(m_data + position, m_size - position, new_array + position + count);
+        } catch (...) {
+            destroy(new_array + position, count);
+            AllocatorTraits::deallocate(m_allocator, new_array, new_capacity);
+            throw;
+        }
+        // хвост уже переехал и в старом буфере разрушен: при ошибке вектор сохраняет только начало
+        try {
+            relocate(m_data, position, new_array);
+        } catch (...) {
+            destroy(new_array + position, m_size - position + count);
+            AllocatorTraits::deallocate(m_allocator, new_array, new_capacity);
+            m_size = position;
+            throw;
+        }
+        deallocate();
+        m_data = new_array;
+        m_capacity = new_capacity;
+        m_size += count;
+        Telemetry::on_reallocate(old_bytes, heap_bytes(), (m_size - count) * sizeof(T));
+    }
+
+    template<typename Construct>
+    void resize_with(std::size_t new_size, Construct construct) {
+        if (new_size <= m_size) {
+            destroy(m_data + new_size, m_size - new_size);
+            m_size = new_size;
+            return;
+        }
+        if (new_size > m_capacity) {
+            reserve(std::max(new_size, next_capacity()));
+        }
+        for (; m_size < new_size; ++m_size) {
+            construct(m_data + m_size);
+        }
+    }
+
+public:
+    Vector() = default;
+
+    explicit Vector(const Allocator& allocator) : m_allocator(allocator) {}
+    
+    Vector(std::size_t initial_capacity) {
+        reserve(initial_capacity);
+    }
     
-    Vector(Vector&& other) noexcept 
-        : m_data(std::exchange(other.m_data, nullptr)),
-          m_size(std::exchange(other.m_size, 0)),
-          m_capacity(std::exchange(other.m_capacity, 0)) {}
+    Vector(std::initializer_list<T> list) : Vector(copy_tag{}, list.begin(), list.size()) {}
+
+    Vector(const Vector& other)
+        : Vector(copy_tag{}, other.m_data, other.m_size, other.m_capacity,
+                 AllocatorTraits::select_on_container_copy_construction(other.m_allocator)) {}
+    
+    Vector(Vector&& other) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>)
+        : m_allocator(std::move(other.m_allocator)) {
+        take(other);
+    }
     
     Vector& operator=(Vector other) {
         swap(other);
@@ -47,15 +662,25 @@ public:
     }
     
     ~Vector() {
-        delete[] m_data;
+        Telemetry::on_destroy(m_size * sizeof(T), heap_bytes());
+        destroy(m_data, m_size);
+        deallocate();
     }
     
-    void swap(Vector& other) noexcept {
-        std::swap(m_data, other.m_data);
-        std::swap(m_size, other.m_size);
-        std::swap(m_capacity, other.m_capacity);
+    void swap(Vector& other) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>) {
+        if (!is_inline() && !other.is_inline()) {
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+            std::swap(m_capacity, other.m_capacity);
+            std::swap(m_allocator, other.m_allocator);
+            return;
+        }
+        // элементы малого буфера приходится переносить поштучно
+        Vector temp(std::move(other));
+        other.take(*this);
+        take(temp);
+        std::swap(m_allocator, other.m_allocator);
     }
-    
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -63,47 +688,535 @@ public:
     std::size_t capacity() const { return m_capacity; }
     bool empty() const { return m_size == 0; }
     
-    int& operator[](std::size_t index) { return m_data[index]; }
-    const int& operator[](std::size_t index) const { return m_data[index]; }
+    T* data() { return m_data; }
+    const T* data() const { return m_data; }
+
+    T* begin() { return m_data; }
+    T* end() { return m_data + m_size; }
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_size; }
+
+    T& operator[](std::size_t index) { return m_data[index]; }
+    const T& operator[](std::size_t index) const { return m_data[index]; }
     
     void reserve(std::size_t new_capacity) {
+        Telemetry::on_reserve();
         if (new_capacity <= m_capacity)
             return;
 
-        int *new_array = new int[new_capacity];
+        reallocate(new_capacity);
+    }
 
-        if (m_data) {
-            std::ranges::copy(m_data, m_data + m_size, new_array);
-            delete[] m_data;
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (m_size < m_capacity) {
+            AllocatorTraits::construct(m_allocator, m_data + m_size, std::forward<Args>(args)...);
+            return m_data[m_size++];
         }
-
+        // новый элемент строится раньше переноса старых: аргумент может ссылаться на элемент вектора
+        if constexpr (can_reallocate) {
+            T value(std::forward<Args>(args)...);
+            reallocate(next_capacity());
+            AllocatorTraits::construct(m_allocator, m_data + m_size, value);
+            return m_data[m_size++];
+        }
+        std::size_t new_capacity = next_capacity();
+        T* new_array = AllocatorTraits::allocate(m_allocator, new_capacity);
+        try {
+            AllocatorTraits::construct(m_allocator, new_array + m_size, std::forward<Args>(args)...);
+        } catch (...) {
+            AllocatorTraits::deallocate(m_allocator, new_array, new_capacity);
+            throw;
+        }
+        try {
+            relocate(m_data, m_size, new_array);
+        } catch (...) {
+            AllocatorTraits::destroy(m_allocator, new_array + m_size);
+            AllocatorTraits::deallocate(m_allocator, new_array, new_capacity);
+            throw;
+        }
+        std::size_t old_bytes = heap_bytes();
+        deallocate();
         m_data = new_array;
         m_capacity = new_capacity;
+        Telemetry::on_reallocate(old_bytes, heap_bytes(), m_size * sizeof(T));
+        return m_data[m_size++];
     }
     
-    void push_back(int value) {
-        if (m_size == m_capacity) {
-            reserve(m_capacity == 0 ? 1 : m_capacity * 2);
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() {
+        assert(m_size > 0);
+        --m_size;
+        AllocatorTraits::destroy(m_allocator, m_data + m_size);
+    }
+
+    void resize(std::size_t new_size) {
+        if constexpr (can_fill) {
+            resize(new_size, T());
+        } else {
+            resize_with(new_size, [this](T* slot) { AllocatorTraits::construct(m_allocator, slot); });
         }
+    }
 
-        m_data[m_size] = value;
-        ++m_size;
+    void resize(std::size_t new_size, const T& value) {
+        if (new_size > m_capacity && m_size > 0 && &value >= m_data && &value < m_data + m_size) {
+            T copy = value;
+            resize(new_size, copy);
+            return;
+        }
+        if constexpr (can_fill) {
+            if (new_size > m_size) {
+                if (new_size > m_capacity) {
+                    reserve(std::max(new_size, next_capacity()));
+                }
+                m_allocator.fill(m_data + m_size, new_size - m_size, value);
+                m_size = new_size;
+                return;
+            }
+        }
+        resize_with(new_size, [&](T* slot) { AllocatorTraits::construct(m_allocator, slot, value); });
+    }
+
+    void shrink_to_fit() {
+        if (m_capacity > m_size) {
+            reallocate(m_size);
+        }
     }
-    
 
     void clear() {
+        destroy(m_data, m_size);
         m_size = 0;
     }
 
+    // Пакетные операции: итоговый размер известен заранее, поэтому память
+    // перераспределяется не более одного раза
+
+    template<std::ranges::input_range Range>
+    void append(Range&& range) {
+        if constexpr (std::ranges::sized_range<Range> || std::ranges::forward_range<Range>) {
+            if constexpr (contiguous_of_T<Range>) {
+                if (aliases(range)) {
+                    Vector copy(copy_tag{}, std::ranges::data(range), std::ranges::size(range));
+                    append(std::span<const T>(copy.m_data, copy.m_size));
+                    return;
+                }
+            }
+            std::size_t count = static_cast<std::size_t>(std::ranges::distance(range));
+            grow_to(m_size + count);
+            construct_at_end(range, count);
+        } else {
+            for (auto&& value : range) {
+                emplace_back(std::forward<decltype(value)>(value));
+            }
+        }
+    }
+
+    template<std::ranges::forward_range Range>
+    void insert(std::size_t position, Range&& range) {
+        assert(position <= m_size);
+        if constexpr (contiguous_of_T<Range>) {
+            if (aliases(range)) {
+                Vector copy(copy_tag{}, std::ranges::data(range), std::ranges::size(range));
+                insert(position, std::span<const T>(copy.m_data, copy.m_size));
+                return;
+            }
+        }
+        std::size_t count = static_cast<std::size_t>(std::ranges::distance(range));
+        if (count == 0) return;
+        if (m_size + count > m_capacity) {
+            insert_reallocating(position, range, count);
+            return;
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memmove(static_cast<void*>(m_data + position + count), static_cast<const void*>(m_data + position),
+                         (m_size - position) * sizeof(T));
+            std::size_t tail = std::exchange(m_size, position);
+            construct_at_end(range, count);
+            m_size = tail + count;
+        } else {
+            std::size_t after = m_size - position;
+            auto source = std::ranges::begin(range);
+            if (after > count) {
+                for (std::size_t i = m_size - count; i < m_size; ++i) {
+                    AllocatorTraits::construct(m_allocator, m_data + i + count, std::move(m_data[i]));
+                }
+                std::size_t old_size = std::exchange(m_size, m_size + count);
+                std::move_backward(m_data + position, m_data + old_size - count, m_data + old_size);
+                for (std::size_t i = 0; i < count; ++i, ++source) {
+                    m_data[position + i] = *source;
+                }
+            } else {
+                // часть новых элементов ложится в неинициализированную память за концом
+                auto middle = std::ranges::next(source, static_cast<std::ptrdiff_t>(after));
+                std::size_t old_size = m_size;
+                for (auto it = middle; m_size < position + count; ++it, ++m_size) {
+                    AllocatorTraits::construct(m_allocator, m_data + m_size, *it);
+                }
+                for (std::size_t i = position; i < old_size; ++i, ++m_size) {
+                    AllocatorTraits::construct(m_allocator, m_data + i + count, std::move(m_data[i]));
+                }
+                for (std::size_t i = position; i < old_size; ++i, ++source) {
+                    m_data[i] = *source;
+                }
+            }
+        }
+    }
+
+    void erase(std::size_t first, std::size_t last) {
+        assert(first <= last && last <= m_size);
+        if (first == last) return;
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memmove(static_cast<void*>(m_data + first), static_cast<const void*>(m_data + last),
+                         (m_size - last) * sizeof(T));
+        } else {
+            std::move(m_data + last, m_data + m_size, m_data + first);
+            destroy(m_data + m_size - (last - first), last - first);
+        }
+        m_size -= last - first;
+    }
+
+    template<std::ranges::input_range Range>
+    void assign(Range&& range) {
+        if constexpr (std::ranges::sized_range<Range> || std::ranges::forward_range<Range>) {
+            if constexpr (contiguous_of_T<Range>) {
+                if (aliases(range)) {
+                    Vector copy(copy_tag{}, std::ranges::data(range), std::ranges::size(range));
+                    assign(std::span<const T>(copy.m_data, copy.m_size));
+                    return;
+                }
+            }
+            std::size_t count = static_cast<std::size_t>(std::ranges::distance(range));
+            clear();
+            if (count > m_capacity) {
+                reallocate(count);
+            }
+            construct_at_end(range, count);
+        } else {
+            clear();
+            append(std::forward<Range>(range));
+        }
+    }
+
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////
 };
 
+template<typename T, std::size_t N>
+using SmallVector = Vector<T, std::allocator<T>, DoublingGrowth, N>;
+
+template<typename T, TelemetryTag Tag>
+using InstrumentedVector = Vector<T, std::allocator<T>, DoublingGrowth, 0, CountingTelemetry<Tag>>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Пул потоков и параллельные алгоритмы над непрерывными диапазонами (Vector, std::vector, span).
+// Буфер режется на куски по числу потоков с границами по 64-байтным строкам кэша,
+// внутренние циклы простые, чтобы компилятор их векторизовал
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads = std::max(1u, std::thread::hardware_concurrency())) {
+        for (unsigned i = 1; i < threads; ++i) {
+            m_workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
 
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+    }
 
+    std::size_t size() const { return m_workers.size() + 1; }
+
+    // вызывает task(i) для всех i из [0, tasks) и ждет завершения; вызывающий поток тоже работает
+    template<typename F>
+    void run(std::size_t tasks, F&& task) {
+        if (m_workers.empty() || tasks <= 1) {
+            for (std::size_t i = 0; i < tasks; ++i) task(i);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task = [&task](std::size_t i) { task(i); };
+            m_tasks = tasks;
+            m_next = 0;
+            m_pending = m_workers.size();
+            ++m_generation;
+        }
+        m_wake.notify_all();
+        execute();
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_pending == 0; });
+        m_task = nullptr;
+    }
+
+private:
+    void execute() {
+        for (std::size_t i; (i = m_next.fetch_add(1, std::memory_order_relaxed)) < m_tasks;) {
+            m_task(i);
+        }
+    }
+
+    void work() {
+        std::size_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+                if (m_stop) return;
+                seen = m_generation;
+            }
+            execute();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_pending == 0) {
+                m_done.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    std::function<void(std::size_t)> m_task;
+    std::size_t m_tasks = 0;
+    std::atomic<std::size_t> m_next{0};
+    std::size_t m_pending = 0;
+    std::size_t m_generation = 0;
+    bool m_stop = false;
+};
+
+// Мельче этого делить невыгодно: запуск задачи дороже самой работы
+constexpr std::size_t minParallelChunk = 16 * 1024;
+
+template<typename T>
+struct alignas(64) PaddedValue {
+    T value;
+};
+
+// Граница куска chunk из chunks, сдвинутая вниз к началу строки кэша,
+// чтобы соседние потоки не писали в одну строку
+template<typename T>
+std::size_t chunkBoundary(const T* data, std::size_t size, std::size_t chunk, std::size_t chunks) {
+    if (chunk >= chunks) return size;
+    std::size_t index = size * chunk / chunks;
+    if constexpr (64 % sizeof(T) == 0) {
+        constexpr std::size_t perLine = 64 / sizeof(T);
+        std::size_t lead = (perLine - reinterpret_cast<std::uintptr_t>(data) % 64 / sizeof(T)) % perLine;
+        if (index > lead) {
+            index = lead + (index - lead) / perLine * perLine;
+        }
+    }
+    return index;
+}
+
+inline std::size_t chunkCount(const ThreadPool& pool, std::size_t size) {
+    return std::clamp<std::size_t>(size / minParallelChunk, 1, pool.size());
+}
+
+// body(first, last, chunk) для каждого куска
+template<typename T, typename Body>
+void forEachChunk(ThreadPool& pool, const T* data, std::size_t size, std::size_t chunks, Body&& body) {
+    pool.run(chunks, [&](std::size_t chunk) {
+        std::size_t first = chunkBoundary(data, size, chunk, chunks);
+        std::size_t last = chunkBoundary(data, size, chunk + 1, chunks);
+        if (first < last) body(first, last, chunk);
+    });
+}
+
+template<std::ranges::contiguous_range Range>
+void parallelFill(ThreadPool& pool, Range&& range, const std::ranges::range_value_t<Range>& value) {
+    auto* data = std::ranges::data(range);
+    std::size_t size = std::ranges::size(range);
+    forEachChunk(pool, data, size, chunkCount(pool, size), [&](std::size_t first, std::size_t last, std::size_t) {
+        std::fill(data + first, data + last, value);
+    });
+}
+
+template<std::ranges::contiguous_range Range>
+void parallelIota(ThreadPool& pool, Range&& range, std::ranges::range_value_t<Range> start) {
+    using T = std::ranges::range_value_t<Range>;
+    T* data = std::ranges::data(range);
+    std::size_t size = std::ranges::size(range);
+    forEachChunk(pool, data, size, chunkCount(pool, size), [&](std::size_t first, std::size_t last, std::size_t) {
+        for (std::size_t i = first; i < last; ++i) {
+            data[i] = start + static_cast<T>(i);
+        }
+    });
+}
+
+template<std::ranges::contiguous_range Input, std::ranges::contiguous_range Output, typename Op>
+void parallelTransform(ThreadPool& pool, const Input& input, Output&& output, Op op) {
+    const auto* in = std::ranges::data(input);
+    auto* out = std::ranges::data(output);
+    std::size_t size = std::ranges::size(input);
+    assert(std::ranges::size(output) >= size);
+    // режем по выходу: пишущие потоки не должны делить строки кэша
+    forEachChunk(pool, out, size, chunkCount(pool, size), [&](std::size_t first, std::size_t last, std::size_t) {
+        for (std::size_t i = first; i < last; ++i) {
+            out[i] = op(in[i]);
+        }
+    });
+}
+
+// Порядок сложения частичных сумм фиксирован при одинаковом размере пула
+template<std::ranges::contiguous_range Range, typename T, typename Op = std::plus<>>
+T parallelReduce(ThreadPool& pool, const Range& range, T init, Op op = {}) {
+    const auto* data = std::ranges::data(range);
+    std::size_t size = std::ranges::size(range);
+    if (size == 0) return init;
+    std::size_t chunks = chunkCount(pool, size);
+    std::vector<PaddedValue<T>> partial(chunks, PaddedValue<T>{init});
+    std::vector<char> filled(chunks, 0);
+    forEachChunk(pool, data, size, chunks, [&](std::size_t first, std::size_t last, std::size_t chunk) {
+        T accumulator = data[first];
+        for (std::size_t i = first + 1; i < last; ++i) {
+            accumulator = op(accumulator, data[i]);
+        }
+        partial[chunk].value = accumulator;
+        filled[chunk] = 1;
+    });
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        if (filled[chunk]) init = op(init, partial[chunk].value);
+    }
+    return init;
+}
+
+// Два прохода: свертка каждого куска, затем скан кусков со сдвигом на сумму предыдущих.
+// Выход может совпадать со входом
+template<std::ranges::contiguous_range Input, std::ranges::contiguous_range Output, typename Op = std::plus<>>
+void parallelInclusiveScan(ThreadPool& pool, const Input& input, Output&& output, Op op = {}) {
+    using T = std::ranges::range_value_t<Output>;
+    const auto* in = std::ranges::data(input);
+    T* out = std::ranges::data(output);
+    std::size_t size = std::ranges::size(input);
+    assert(std::ranges::size(output) >= size);
+    if (size == 0) return;
+    std::size_t chunks = chunkCount(pool, size);
+    std::vector<PaddedValue<T>> totals(chunks);
+    std::vector<char> filled(chunks, 0);
+    forEachChunk(pool, out, size, chunks, [&](std::size_t first, std::size_t last, std::size_t chunk) {
+        if (chunk + 1 == chunks) return;
+        T accumulator = in[first];
+        for (std::size_t i = first + 1; i < last; ++i) {
+            accumulator = op(accumulator, in[i]);
+        }
+        totals[chunk].value = accumulator;
+        filled[chunk] = 1;
+    });
+    // prefix[c] - свертка всех кусков до c
+    std::vector<std::optional<T>> prefix(chunks);
+    std::optional<T> carry;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        prefix[chunk] = carry;
+        if (filled[chunk]) {
+            carry = carry ? op(*carry, totals[chunk].value) : totals[chunk].value;
+        }
+    }
+    forEachChunk(pool, out, size, chunks, [&](std::size_t first, std::size_t last, std::size_t chunk) {
+        T accumulator = prefix[chunk] ? op(*prefix[chunk], in[first]) : T(in[first]);
+        out[first] = accumulator;
+        for (std::size_t i = first + 1; i < last; ++i) {
+            accumulator = op(accumulator, in[i]);
+            out[i] = accumulator;
+        }
+    });
+}
+
+// Считает живые объекты, чтобы проверить, что лишняя емкость не конструируется
+struct Tracked {
+    static inline int alive = 0;
+    // при неотрицательном значении столько копий пройдет, а следующая бросит исключение
+    static inline int copiesBeforeThrow = -1;
+    int value;
+
+    Tracked(int v = 0) : value(v) { ++alive; }
+    Tracked(const Tracked& other) : value(other.value) {
+        if (copiesBeforeThrow == 0) throw std::runtime_error("Tracked copy failed");
+        if (copiesBeforeThrow > 0) --copiesBeforeThrow;
+        ++alive;
+    }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++alive; }
+    Tracked& operator=(const Tracked&) = default;
+    ~Tracked() { --alive; }
+};
+
+// перемещение может бросить, поэтому при переезде такие элементы копируются
+struct CopiedTracked : Tracked {
+    using Tracked::Tracked;
+    CopiedTracked(const CopiedTracked&) = default;
+    CopiedTracked(CopiedTracked&& other) : Tracked(other) {}
+    CopiedTracked& operator=(const CopiedTracked&) = default;
+};
+
+struct Pod64 {
+    std::int64_t fields[8];
+};
+
+// Отдает один статический блок и всегда "растит" его на месте
+struct InPlaceAllocator {
+    using value_type = int;
+    static inline std::array<int, 64> storage;
+
+    int* allocate(std::size_t) { return storage.data(); }
+    void deallocate(int*, std::size_t) {}
+    int* reallocate(int* pointer, std::size_t, std::size_t) { return pointer; }
+    bool operator==(const InPlaceAllocator&) const = default;
+};
+
+// Сколько анонимной памяти процесса сейчас лежит в больших страницах
+std::size_t anonHugePageBytes() {
+    std::ifstream smaps("/proc/self/smaps_rollup");
+    std::string key;
+    std::size_t kilobytes = 0;
+    while (smaps >> key) {
+        if (key == "AnonHugePages:") {
+            smaps >> kilobytes;
+            return kilobytes * 1024;
+        }
+    }
+    return 0;
+}
+
+template<typename F>
+long long measureMicroseconds(F&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+template<typename Container, typename Make>
+long long pushBackBenchmark(std::size_t count, Make make) {
+    return measureMicroseconds([&] {
+        for (int round = 0; round < 5; ++round) {
+            Container container;
+            for (std::size_t i = 0; i < count; ++i) {
+                container.push_back(make(i));
+            }
+            assert(container.size() == count);
+        }
+    });
+}
 
 int main() {
-    Vector vec;
+    Vector<int> vec;
     assert(vec.empty());
     std::cout << "empty test passed \n"; 
     
@@ -121,6 +1234,499 @@ int main() {
     assert(vec.size() == 0);
     assert(vec.capacity() == 32);
     std::cout << "vector.clear test passed \n"; 
+
+    {
+        Vector<Tracked> tracked(100);
+        assert(tracked.capacity() == 100 && Tracked::alive == 0);
+        tracked.emplace_back(1);
+        tracked.push_back(Tracked(2));
+        assert(Tracked::alive == 2);
+        tracked.resize(10, Tracked(7));
+        assert(Tracked::alive == 10 && tracked[9].value == 7);
+        tracked.resize(3);
+        assert(Tracked::alive == 3 && tracked.size() == 3);
+        tracked.pop_back();
+        assert(Tracked::alive == 2);
+        tracked.shrink_to_fit();
+        assert(tracked.capacity() == 2 && tracked[1].value == 2);
+        // аргумент ссылается на элемент, который переезжает при росте
+        tracked.push_back(tracked[0]);
+        assert(tracked.capacity() == 4 && tracked[2].value == 1);
+        Vector<Tracked> copy = tracked;
+        assert(Tracked::alive == 6 && copy[2].value == 1);
+        copy.clear();
+        assert(Tracked::alive == 3);
+
+        // исключение на третьей копии: уже скопированные элементы разрушаются, память возвращается
+        Tracked::copiesBeforeThrow = 2;
+        bool copyThrows = false;
+        try {
+            Vector<Tracked> failed = tracked;
+        } catch (const std::runtime_error&) {
+            copyThrows = true;
+        }
+        Tracked::copiesBeforeThrow = -1;
+        assert(copyThrows && Tracked::alive == 3);
+    }
+    assert(Tracked::alive == 0);
+
+    Vector<std::string> strings{"alpha", "beta"};
+    strings.emplace_back(40, 'x');
+    for (int i = 0; i < 100; ++i) {
+        strings.push_back(std::to_string(i));
+    }
+    assert(strings.size() == 103 && strings[2] == std::string(40, 'x') && strings[102] == "99");
+    Vector<std::string> movedStrings = std::move(strings);
+    assert(strings.empty() && movedStrings[0] == "alpha");
+
+    Vector<std::unique_ptr<int>> owners;
+    for (int i = 0; i < 10; ++i) {
+        owners.emplace_back(std::make_unique<int>(i));
+    }
+    assert(*owners[9] == 9);
+    owners.resize(12);
+    assert(owners[11] == nullptr);
+    std::cout << "generic element types test passed \n";
+
+    const std::size_t count = 1'000'000;
+    std::string longText(32, 's');
+    std::cout << "push_back x" << count << " (5 rounds), Vector vs std::vector:\n";
+    std::cout << "  int:         " << pushBackBenchmark<Vector<int>>(count, [](std::size_t i) { return static_cast<int>(i); })
+              << " us vs " << pushBackBenchmark<std::vector<int>>(count, [](std::size_t i) { return static_cast<int>(i); })
+              << " us\n";
+    auto makeString = [&](std::size_t) { return longText; };
+    std::cout << "  std::string: " << pushBackBenchmark<Vector<std::string>>(count, makeString)
+              << " us vs " << pushBackBenchmark<std::vector<std::string>>(count, makeString) << " us\n";
+    auto makePod = [](std::size_t i) { return Pod64{{static_cast<std::int64_t>(i)}}; };
+    std::cout << "  64-byte POD: " << pushBackBenchmark<Vector<Pod64>>(count, makePod)
+              << " us vs " << pushBackBenchmark<std::vector<Pod64>>(count, makePod) << " us\n";
+
+    {
+        SmallVector<int, 4> small;
+        assert(small.empty() && small.capacity() == 4);
+        for (int i = 0; i < 4; ++i) {
+            small.push_back(i);
+        }
+        assert(small.capacity() == 4);
+        small.push_back(4);
+        assert(small.capacity() == 8 && small[4] == 4);
+        small.resize(3);
+        small.shrink_to_fit();
+        assert(small.capacity() == 4 && small[2] == 2);
+
+        SmallVector<Tracked, 2> inlineTracked;
+        inlineTracked.emplace_back(1);
+        SmallVector<Tracked, 2> heapTracked{Tracked(5), Tracked(6), Tracked(7)};
+        assert(Tracked::alive == 4 && heapTracked.capacity() == 3);
+        inlineTracked.swap(heapTracked);
+        assert(inlineTracked.size() == 3 && inlineTracked[2].value == 7);
+        assert(heapTracked.size() == 1 && heapTracked[0].value == 1 && heapTracked.capacity() == 2);
+        SmallVector<Tracked, 2> movedInline = std::move(heapTracked);
+        assert(heapTracked.empty() && movedInline[0].value == 1 && Tracked::alive == 4);
+        SmallVector<Tracked, 2> movedHeap = std::move(inlineTracked);
+        assert(inlineTracked.empty() && inlineTracked.capacity() == 2 && movedHeap.size() == 3);
+        movedInline = movedHeap;
+        assert(movedInline.size() == 3 && movedInline[0].value == 5 && Tracked::alive == 6);
+        movedInline.clear();
+        movedInline.reserve(1);
+        assert(movedInline.capacity() == 3 && Tracked::alive == 3);
+    }
+    assert(Tracked::alive == 0);
+    std::cout << "small buffer test passed \n";
+
+    // миллионы коротких векторов: малый буфер против выделения в куче
+    {
+        const int vectors = 2'000'000;
+        long long heapSum = 0, smallSum = 0;
+        long long heapTime = measureMicroseconds([&] {
+            for (int i = 0; i < vectors; ++i) {
+                Vector<int> shortVector;
+                for (int j = 0; j <= i % 16; ++j) shortVector.push_back(j);
+                heapSum += shortVector[shortVector.size() - 1];
+            }
+        });
+        long long smallTime = measureMicroseconds([&] {
+            for (int i = 0; i < vectors; ++i) {
+                SmallVector<int, 16> shortVector;
+                for (int j = 0; j <= i % 16; ++j) shortVector.push_back(j);
+                smallSum += shortVector[shortVector.size() - 1];
+            }
+        });
+        assert(heapSum == smallSum);
+        std::cout << "2e6 vectors of 1..16 ints: Vector " << heapTime << " us, SmallVector<int, 16> "
+                  << smallTime << " us\n";
+    }
+
+    {
+        Vector<int> numbers{1, 2, 3};
+        std::vector<int> source{10, 20, 30, 40};
+        numbers.append(source);
+        assert(numbers.size() == 7 && numbers[6] == 40);
+        numbers.insert(1, std::span<const int>(source.data(), 2));
+        assert(numbers.size() == 9 && numbers[1] == 10 && numbers[2] == 20 && numbers[3] == 2);
+        numbers.erase(0, 3);
+        assert(numbers.size() == 6 && numbers[0] == 2 && numbers[5] == 40);
+        numbers.append(std::span<const int>(numbers.data(), numbers.size()));
+        assert(numbers.size() == 12 && numbers[6] == 2 && numbers[11] == 40);
+        numbers.insert(12, std::views::iota(0, 3));
+        numbers.insert(0, std::views::iota(100, 101));
+        assert(numbers.size() == 16 && numbers[0] == 100 && numbers[15] == 2);
+        numbers.assign(std::span<const int>(numbers.data() + 1, 3));
+        assert(numbers.size() == 3 && numbers[0] == 2 && numbers[2] == 10);
+
+        Vector<std::string> words{"a", "b", "c", "d"};
+        words.reserve(16);
+        std::vector<std::string> one{"x"}, three{"x", "y", "z"};
+        words.insert(1, one);
+        words.insert(1, three);
+        words.insert(7, three);
+        assert(words.size() == 11 && words.capacity() == 16);
+        std::string joined;
+        for (std::size_t i = 0; i < words.size(); ++i) joined += words[i];
+        assert(joined == "axyzxbcxyzd");
+        words.insert(0, std::vector<std::string>(10, "w"));
+        assert(words.size() == 21 && words[0] == "w" && words[10] == "a" && words[20] == "d");
+        words.erase(0, 10);
+        assert(words.size() == 11 && words[0] == "a");
+        words.assign(three);
+        assert(words.size() == 3 && words[2] == "z");
+        words.erase(1, 3);
+        words.append(one);
+        assert(words.size() == 2 && words[0] == "x" && words[1] == "x");
+
+        Vector<Tracked> tracked;
+        tracked.append(std::vector<Tracked>(5));
+        tracked.erase(1, 4);
+        assert(tracked.size() == 2 && Tracked::alive == 2);
+
+        // вставка с переездом падает на переносе начала: хвост и вставленное разрушаются,
+        // вектор остается согласованным и сохраняет начало
+        Vector<CopiedTracked> copied{CopiedTracked(1), CopiedTracked(2), CopiedTracked(3), CopiedTracked(4)};
+        std::vector<CopiedTracked> inserted(1);
+        Tracked::copiesBeforeThrow = 4;
+        bool insertThrows = false;
+        try {
+            copied.insert(2, inserted);
+        } catch (const std::runtime_error&) {
+            insertThrows = true;
+        }
+        Tracked::copiesBeforeThrow = -1;
+        assert(insertThrows && copied.size() == 2 && copied[1].value == 2);
+        assert(Tracked::alive == 2 + 2 + 1);
+    }
+    assert(Tracked::alive == 0);
+    std::cout << "bulk insert, erase and append test passed \n";
+
+    {
+        const std::size_t count = 10'000'000;
+        std::vector<int> source(count);
+        for (std::size_t i = 0; i < count; ++i) source[i] = static_cast<int>(i);
+        std::span<const int> view(source);
+        Vector<int> appended, pushed;
+        long long appendTime = measureMicroseconds([&] { appended.append(view); });
+        long long pushTime = measureMicroseconds([&] {
+            for (int value : view) pushed.push_back(value);
+        });
+        Vector<int> front{-1};
+        long long insertTime = measureMicroseconds([&] { front.insert(0, view); });
+        assert(appended.size() == count && pushed.size() == count && front[count] == -1);
+        std::cout << "1e7 ints: append from span " << appendTime << " us, push_back loop " << pushTime
+                  << " us, insert at front " << insertTime << " us\n";
+    }
+
+    {
+        ThreadPool pool(4);
+        for (std::size_t size : {std::size_t(0), std::size_t(1), std::size_t(1000), std::size_t(100'003)}) {
+            Vector<long long> values;
+            values.resize(size);
+            parallelIota(pool, values, 5LL);
+            std::vector<long long> expected(size);
+            for (std::size_t i = 0; i < size; ++i) expected[i] = 5 + static_cast<long long>(i);
+            assert(std::equal(values.begin(), values.end(), expected.begin(), expected.end()));
+
+            long long sum = parallelReduce(pool, values, 0LL);
+            long long expectedSum = 0;
+            for (long long value : expected) expectedSum += value;
+            assert(sum == expectedSum);
+
+            Vector<double> halves;
+            halves.resize(size);
+            parallelTransform(pool, values, halves, [](long long v) { return v / 2.0; });
+            assert(size == 0 || halves[size - 1] == expected[size - 1] / 2.0);
+
+            parallelInclusiveScan(pool, values, values);
+            long long running = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                running += expected[i];
+                assert(values[i] == running);
+            }
+
+            parallelFill(pool, values, -1LL);
+            assert(std::all_of(values.begin(), values.end(), [](long long v) { return v == -1; }));
+        }
+        // операция, отличная от сложения (max ассоциативен): параллельные максимумы префиксов
+        // должны совпасть с последовательными
+        Vector<int> noisy;
+        for (int i = 0; i < 70'000; ++i) noisy.push_back((i * 7919) % 1000);
+        Vector<int> maxima;
+        maxima.resize(noisy.size());
+        auto maximum = [](int a, int b) { return std::max(a, b); };
+        parallelInclusiveScan(pool, noisy, maxima, maximum);
+        int best = 0;
+        for (std::size_t i = 0; i < noisy.size(); ++i) {
+            best = std::max(best, noisy[i]);
+            assert(maxima[i] == best);
+        }
+        int reducedMax = parallelReduce(pool, noisy, 0, maximum);
+        assert(reducedMax == 999);
+    }
+    std::cout << "parallel algorithms test passed \n";
+
+    // сборка с -DWITH_PARALLEL_STL -ltbb добавляет сравнение с std::execution::par_unseq
+    {
+        const std::size_t count = std::size_t(1) << 25;
+        ThreadPool pool;
+        Vector<std::uint64_t> values, results;
+        values.resize(count);
+        results.resize(count);
+        auto square = [](std::uint64_t v) { return v * v + 1; };
+        std::uint64_t checksum[2] = {};
+
+        long long serialFill = measureMicroseconds([&] { for (std::size_t i = 0; i < count; ++i) values[i] = 3; });
+        long long serialIota = measureMicroseconds([&] { for (std::size_t i = 0; i < count; ++i) values[i] = i; });
+        long long serialTransform = measureMicroseconds([&] {
+            for (std::size_t i = 0; i < count; ++i) results[i] = square(values[i]);
+        });
+        long long serialReduce = measureMicroseconds([&] {
+            for (std::size_t i = 0; i < count; ++i) checksum[0] += results[i];
+        });
+        long long serialScan = measureMicroseconds([&] {
+            for (std::size_t i = 1; i < count; ++i) results[i] += results[i - 1];
+        });
+        std::uint64_t serialLast = results[count - 1];
+
+        long long poolFill = measureMicroseconds([&] { parallelFill(pool, values, std::uint64_t(3)); });
+        long long poolIota = measureMicroseconds([&] { parallelIota(pool, values, std::uint64_t(0)); });
+        long long poolTransform = measureMicroseconds([&] { parallelTransform(pool, values, results, square); });
+        long long poolReduce = measureMicroseconds([&] { checksum[1] = parallelReduce(pool, results, std::uint64_t(0)); });
+        long long poolScan = measureMicroseconds([&] { parallelInclusiveScan(pool, results, results); });
+        assert(checksum[0] == checksum[1] && results[count - 1] == serialLast);
+
+        std::cout << "2^25 uint64, " << pool.size() << " threads (serial / pool):\n"
+                  << "  fill " << serialFill << " / " << poolFill << " us\n"
+                  << "  iota " << serialIota << " / " << poolIota << " us\n"
+                  << "  transform " << serialTransform << " / " << poolTransform << " us\n"
+                  << "  reduce " << serialReduce << " / " << poolReduce << " us\n"
+                  << "  inclusive_scan " << serialScan << " / " << poolScan << " us\n";
+#ifdef WITH_PARALLEL_STL
+        const auto policy = std::execution::par_unseq;
+        long long stlFill = measureMicroseconds([&] { std::fill(policy, values.begin(), values.end(), 3); });
+        long long stlTransform = measureMicroseconds([&] {
+            std::transform(policy, values.begin(), values.end(), results.begin(), square);
+        });
+        std::uint64_t stlSum = 0;
+        long long stlReduce = measureMicroseconds([&] { stlSum = std::reduce(policy, results.begin(), results.end()); });
+        long long stlScan = measureMicroseconds([&] {
+            std::inclusive_scan(policy, results.begin(), results.end(), results.begin());
+        });
+        assert(stlSum == count * 10);
+        std::cout << "  par_unseq: fill " << stlFill << " us, transform " << stlTransform << " us, reduce "
+                  << stlReduce << " us, inclusive_scan " << stlScan << " us\n";
+#endif
+    }
+
+    {
+        Vector<int, HugePageAllocator<int>> small;
+        for (int i = 0; i < 1000; ++i) small.push_back(i);
+        HugePageAllocator<std::uint64_t> bound(0, 2);
+        Vector<std::uint64_t, HugePageAllocator<std::uint64_t>> large(bound);
+        large.resize(3 * 1024 * 1024, 7);
+        assert(reinterpret_cast<std::uintptr_t>(large.data()) % HugePageAllocator<int>::hugePageSize == 0);
+        assert(large[0] == 7 && large[large.size() - 1] == 7 && small[999] == 999);
+        Vector<std::uint64_t, HugePageAllocator<std::uint64_t>> copy = large;
+        assert(copy[12345] == 7);
+        Vector<std::uint64_t, HugePageAllocator<std::uint64_t>> zeroed(HugePageAllocator<std::uint64_t>(-1, 3));
+        zeroed.resize(1024 * 1024);
+        zeroed.resize(2 * 1024 * 1024 + 1, 5);
+        assert(zeroed[1024 * 1024 - 1] == 0 && zeroed[1024 * 1024] == 5 && zeroed[2 * 1024 * 1024] == 5);
+
+        // привязка к несуществующему узлу не проходит, и это видно по счетчику
+        std::size_t failuresBefore = HugePageStats::numaBindFailures;
+        HugePageAllocator<std::uint64_t> missingNode(1000);
+        std::uint64_t* unbound = missingNode.allocate(1024 * 1024);
+        unbound[0] = 1;
+        missingNode.deallocate(unbound, 1024 * 1024);
+        assert(HugePageStats::numaBindFailures == failuresBefore + 1);
+    }
+    std::cout << "huge page allocator test passed \n";
+
+    // 1 ГБ: последовательный и случайный доступ с большими страницами и без
+    {
+        const std::size_t elements = (std::size_t(1) << 30) / sizeof(std::uint64_t);
+        unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+        for (bool hugePages : {false, true}) {
+            std::size_t hugeBefore = anonHugePageBytes();
+            Vector<std::uint64_t, HugePageAllocator<std::uint64_t>> buffer(HugePageAllocator<std::uint64_t>(-1, threads, hugePages));
+            long long fillTime = measureMicroseconds([&] { buffer.resize(elements, 1); });
+            std::size_t hugeBytes = anonHugePageBytes() - std::min(hugeBefore, anonHugePageBytes());
+            std::uint64_t sum = 0;
+            long long sequentialTime = measureMicroseconds([&] {
+                for (std::size_t i = 0; i < elements; ++i) sum += buffer[i];
+            });
+            std::uint64_t state = 12345;
+            long long randomTime = measureMicroseconds([&] {
+                for (int i = 0; i < 20'000'000; ++i) {
+                    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                    sum += buffer[(state >> 20) % elements];
+                }
+            });
+            assert(sum == elements + 20'000'000);
+            std::cout << (hugePages ? "huge pages: " : "4K pages:   ") << "fill " << fillTime << " us, sequential "
+                      << sequentialTime << " us, 2e7 random reads " << randomTime << " us, "
+                      << hugeBytes / (1024 * 1024) << " MiB in huge pages\n";
+        }
+    }
+
+    {
+        {
+            InstrumentedVector<int, "parser"> parsed;
+            for (int i = 0; i < 100; ++i) {
+                parsed.push_back(i);
+            }
+            InstrumentedVector<int, "parser"> reserved;
+            reserved.reserve(10);
+            reserved.push_back(1);
+            InstrumentedVector<double, "cache"> cached(4);
+            InstrumentedVector<int, "parser"> moved = std::move(parsed);
+            AllocationCounters& parser = CountingTelemetry<"parser">::counters();
+            assert(parser.reserveCalls == 1 && parser.reallocations == 9);
+            assert(parser.bytesCopied == (1 + 2 + 4 + 8 + 16 + 32 + 64) * sizeof(int));
+            assert(parser.peakCapacityBytes == 128 * sizeof(int));
+            assert(parser.liveCapacityBytes == 138 * sizeof(int));
+            assert(AllocationTelemetry::global().liveCapacityBytes == 138 * sizeof(int) + 4 * sizeof(double));
+        }
+        AllocationCounters& parser = CountingTelemetry<"parser">::counters();
+        assert(parser.liveCapacityBytes == 0 && parser.destroyedVectors == 2);
+
+        // рост на месте через reallocate не должен засчитываться как копирование
+        {
+            Vector<int, InPlaceAllocator, DoublingGrowth, 0, CountingTelemetry<"in place">> grown;
+            for (int i = 0; i < 64; ++i) {
+                grown.push_back(i);
+            }
+            assert(grown[63] == 63);
+        }
+        AllocationCounters& inPlace = CountingTelemetry<"in place">::counters();
+        assert(inPlace.reallocations == 7 && inPlace.bytesCopied == 0);
+        assert(parser.slackBytesAtDestruction == (28 + 9) * sizeof(int));
+        assert(AllocationTelemetry::global().reserveCalls == 2);
+        AllocationTelemetry::dump(std::cout);
+    }
+    std::cout << "allocation telemetry test passed \n";
+
+    // политика телеметрии не добавляет полей: вектор - это указатель, размер и емкость
+    // (плюс малый буфер, если он есть); время без телеметрии и с ней сравнивает бенчмарк ниже
+    static_assert(sizeof(Vector<int>) == sizeof(int*) + 2 * sizeof(std::size_t));
+    static_assert(sizeof(InstrumentedVector<int, "bench">) == sizeof(int*) + 2 * sizeof(std::size_t));
+    static_assert(sizeof(SmallVector<int, 4>) == 4 * sizeof(int) + sizeof(int*) + 2 * sizeof(std::size_t));
+    {
+        // много коротких векторов, чтобы хуки роста и разрушения вызывались часто
+        auto fill = [](auto vector) {
+            std::size_t total = 0;
+            for (int round = 0; round < 2'000'000; ++round) {
+                decltype(vector) fresh;
+                for (int i = 0; i < 16; ++i) fresh.push_back(i);
+                total += fresh.size();
+            }
+            return total;
+        };
+        long long stdTime = measureMicroseconds([&] { fill(std::vector<int>()); });
+        long long disabledTime = measureMicroseconds([&] { fill(Vector<int>()); });
+        long long enabledTime = measureMicroseconds([&] { fill(InstrumentedVector<int, "bench">()); });
+        std::cout << "2e6 vectors of 16 ints: std::vector " << stdTime << " us, Vector without telemetry "
+                  << disabledTime << " us, with telemetry " << enabledTime << " us\n";
+    }
+
+    {
+        Vector<int, MallocAllocator<int>> reallocated;
+        Vector<int, std::allocator<int>, GoldenGrowth> golden;
+        Vector<int, MallocAllocator<int>, FixedIncrementGrowth<3>> stepped;
+        for (int i = 0; i < 1000; ++i) {
+            reallocated.push_back(i);
+            golden.push_back(i);
+            stepped.push_back(reallocated[i / 2]);
+        }
+        assert(reallocated.capacity() == 1024 && golden.capacity() == 1066 && stepped.capacity() == 1002);
+        for (int i = 0; i < 1000; ++i) {
+            assert(reallocated[i] == i && golden[i] == i && stepped[i] == i / 2);
+        }
+        reallocated.shrink_to_fit();
+        assert(reallocated.capacity() == 1000 && reallocated[999] == 999);
+
+        // переход через порог mmap и рост внутри отображения
+        Vector<char, MallocAllocator<char>> large;
+        large.resize(MallocAllocator<char>::mapThreshold - 1, 'a');
+        large.push_back('b');
+        large.reserve(3 * MallocAllocator<char>::mapThreshold);
+        assert(large[0] == 'a' && large[large.size() - 1] == 'b');
+        large.shrink_to_fit();
+        assert(large.size() == MallocAllocator<char>::mapThreshold && large[1000] == 'a');
+
+        // число элементов, чей размер в байтах переполняет size_t, отвергается до malloc/mmap
+        const std::size_t wrapping = std::numeric_limits<std::size_t>::max() / sizeof(Pod64) + 2;
+        int rejected = 0;
+        try {
+            MallocAllocator<Pod64>().allocate(wrapping);
+        } catch (const std::bad_array_new_length&) {
+            ++rejected;
+        }
+        Pod64* small = MallocAllocator<Pod64>().allocate(1);
+        try {
+            small = MallocAllocator<Pod64>().reallocate(small, 1, wrapping);
+        } catch (const std::bad_array_new_length&) {
+            ++rejected;
+        }
+        MallocAllocator<Pod64>().deallocate(small, 1);
+        try {
+            HugePageAllocator<Pod64>().allocate(wrapping);
+        } catch (const std::bad_array_new_length&) {
+            ++rejected;
+        }
+        assert(rejected == 3);
+    }
+    std::cout << "realloc growth and growth policies test passed \n";
+
+    // рост до 1e9 байт: объем копирования и время для разных политик и распределителей
+    auto growthBenchmark = [](auto vector, bool reallocates, const char* name) {
+        const std::size_t target = 1'000'000'000 / sizeof(int);
+        std::size_t copied = 0;
+        std::size_t reallocations = 0;
+        ReallocationStats::copiedBytes = 0;
+        ReallocationStats::remappedBytes = 0;
+        long long time = measureMicroseconds([&] {
+            for (std::size_t i = 0; i < target; ++i) {
+                if (vector.size() == vector.capacity()) {
+                    copied += vector.size() * sizeof(int);
+                    ++reallocations;
+                }
+                vector.push_back(static_cast<int>(i));
+            }
+        });
+        // realloc копирует только когда не смог расшириться на месте, mremap не копирует вовсе
+        if (reallocates) {
+            copied = ReallocationStats::copiedBytes;
+        }
+        std::cout << "  " << name << ": " << time << " us, " << reallocations << " reallocations, "
+                  << copied / (1024 * 1024) << " MiB copied, "
+                  << ReallocationStats::remappedBytes / (1024 * 1024) << " MiB remapped\n";
+    };
+    std::cout << "growing to 1e9 bytes of int:\n";
+    growthBenchmark(Vector<int>(), false, "std::allocator, doubling");
+    growthBenchmark(Vector<int, std::allocator<int>, GoldenGrowth>(), false, "std::allocator, 1.5x");
+    growthBenchmark(Vector<int, std::allocator<int>, FixedIncrementGrowth<16 << 20>>(), false, "std::allocator, +16M");
+    growthBenchmark(Vector<int, MallocAllocator<int>>(), true, "realloc/mremap, doubling");
+    growthBenchmark(Vector<int, MallocAllocator<int>, GoldenGrowth>(), true, "realloc/mremap, 1.5x");
+    growthBenchmark(Vector<int, MallocAllocator<int>, FixedIncrementGrowth<16 << 20>>(), true, "realloc/mremap, +16M");
     
     return 0;
 }
\ No newline at end of file
@@ -3,108 +3,1865 @@
 #include <cstdint>
 #include <sstream>
 #include <cassert>
+#include <cmath>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <set>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <string_view>
+#include <system_error>
+#include <span>
+#include <iterator>
+#include <ranges>
+#include <vector>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+#if __has_include(<format>)
+#include <format>
+#endif
+
+// Текст каждого октета: до трех цифр и длина, ровно 4 байта на запись
+struct OctetText {
+    char digits[3];
+    std::uint8_t length;
+};
+
+constexpr std::array<OctetText, 256> makeOctetTexts() {
+    std::array<OctetText, 256> table{};
+    for (int value = 0; value < 256; ++value) {
+        OctetText& entry = table[value];
+        if (value >= 100) entry.digits[entry.length++] = static_cast<char>('0' + value / 100);
+        if (value >= 10) entry.digits[entry.length++] = static_cast<char>('0' + value / 10 % 10);
+        entry.digits[entry.length++] = static_cast<char>('0' + value % 10);
+    }
+    return table;
+}
+
+inline constexpr std::array<OctetText, 256> octetTexts = makeOctetTexts();
+
+#if defined(__SSSE3__)
+// Маски перестановки для векторного разбора: по длинам четырех октетов (1..3) цифры
+// каждого октета раскладываются в свою 32-битную дорожку как [сотни, десятки, единицы, 0]
+struct OctetShuffle {
+    alignas(16) std::uint8_t shuffle[16];
+    std::uint16_t leadingDigits; // позиции первых цифр многозначных октетов
+};
+
+constexpr std::array<OctetShuffle, 81> makeOctetShuffles() {
+    std::array<OctetShuffle, 81> table{};
+    for (int pattern = 0; pattern < 81; ++pattern) {
+        int lengths[4] = {pattern / 27 + 1, pattern / 9 % 3 + 1, pattern / 3 % 3 + 1, pattern % 3 + 1};
+        OctetShuffle entry{};
+        int start = 0;
+        for (int octet = 0; octet < 4; ++octet) {
+            std::uint8_t* lane = entry.shuffle + 4 * octet;
+            lane[0] = lane[1] = lane[2] = lane[3] = 0x80;
+            for (int digit = 0; digit < lengths[octet]; ++digit) {
+                lane[3 - lengths[octet] + digit] = static_cast<std::uint8_t>(start + digit);
+            }
+            if (lengths[octet] > 1) {
+                entry.leadingDigits |= static_cast<std::uint16_t>(1u << start);
+            }
+            start += lengths[octet] + 1;
+        }
+        table[pattern] = entry;
+    }
+    return table;
+}
+
+inline constexpr std::array<OctetShuffle, 81> octetShuffles = makeOctetShuffles();
+#endif
 
 class IPv4 {
 private:
-    std::array<std::uint8_t, 4> data;
+    std::uint32_t value; // порядок байт хоста, первый октет в старших битах
+
+    // пишет адрес без проверок, затрагивая до 16 байт; возвращает конец текста
+    char* writeText(char* out) const {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            const OctetText& octet = octetTexts[value >> shift & 0xFF];
+            std::memcpy(out, &octet, sizeof(octet));
+            out += octet.length;
+            *out++ = '.';
+        }
+        return out - 1;
+    }
+
+public:
+    static constexpr std::size_t maxTextLength = 15;
+    // столько байт нужно formatBulk на каждый адрес
+    static constexpr std::size_t bulkBytesPerAddress = 16;
+
+    constexpr IPv4() : value(0) {}
+    
+    constexpr IPv4(std::uint8_t a, std::uint8_t b, std::uint8_t c, std::uint8_t d)
+        : value(std::uint32_t(a) << 24 | std::uint32_t(b) << 16 | std::uint32_t(c) << 8 | d) {}
+
+    constexpr explicit IPv4(std::uint32_t address) : value(address) {}
+
+    constexpr std::uint32_t toUint32() const { return value; }
+
+    // для общего кода префиксов (BasicPrefix)
+    static constexpr int bitCount = 32;
+
+    constexpr IPv4 maskedTo(int length) const {
+        return IPv4(length == 0 ? 0 : value & ~std::uint32_t(0) << (32 - length));
+    }
+
+    constexpr IPv4 withHostBits(int length) const {
+        return IPv4(length == 32 ? value : value | ~std::uint32_t(0) >> length);
+    }
+
+    // octet(0) - первый октет в записи a.b.c.d
+    constexpr std::uint8_t octet(int index) const {
+        return static_cast<std::uint8_t>(value >> (24 - 8 * index));
+    }
+
+    constexpr std::array<std::uint8_t, 4> octets() const {
+        return {octet(0), octet(1), octet(2), octet(3)};
+    }
+    
+    // арифметика по модулю 2^32, как и раньше у ++ и -- на границах
+    IPv4& operator++() {
+        ++value;
+        return *this;
+    }
+    
+    IPv4 operator++(int) {
+        IPv4 temp = *this;
+        ++(*this);
+        return temp;
+    }
+    
+    IPv4& operator--() {
+        --value;
+        return *this;
+    }
+    
+    IPv4 operator--(int) {
+        IPv4 temp = *this;
+        --(*this);
+        return temp;
+    }
+
+    IPv4& operator+=(std::int64_t offset) {
+        value += static_cast<std::uint32_t>(offset);
+        return *this;
+    }
+
+    IPv4& operator-=(std::int64_t offset) {
+        value -= static_cast<std::uint32_t>(offset);
+        return *this;
+    }
+
+    friend IPv4 operator+(IPv4 ip, std::int64_t offset) {
+        return ip += offset;
+    }
+
+    friend IPv4 operator-(IPv4 ip, std::int64_t offset) {
+        return ip -= offset;
+    }
+
+    // сколько шагов ++ от from до to; отрицательно, если to меньше
+    friend std::int64_t distance(const IPv4& from, const IPv4& to) {
+        return static_cast<std::int64_t>(to.value) - static_cast<std::int64_t>(from.value);
+    }
+    
+    friend bool operator==(const IPv4& lhs, const IPv4& rhs) {
+        return lhs.value == rhs.value;
+    }
+    
+    friend bool operator!=(const IPv4& lhs, const IPv4& rhs) {
+        return !(lhs == rhs);
+    }
+    
+    friend bool operator<(const IPv4& lhs, const IPv4& rhs) {
+        return lhs.value < rhs.value;
+    }
+    
+    friend bool operator>(const IPv4& lhs, const IPv4& rhs) {
+        return rhs < lhs;
+    }
+    
+    friend bool operator<=(const IPv4& lhs, const IPv4& rhs) {
+        return !(rhs < lhs);
+    }
+    
+    friend bool operator>=(const IPv4& lhs, const IPv4& rhs) {
+        return !(lhs < rhs);
+    }
+    
+    // Разбор в стиле std::from_chars: читает адрес с начала [first, last), без выделений памяти.
+    // Октеты строго 0..255 без ведущих нулей; при ошибке ptr указывает на место ошибки
+    friend std::from_chars_result from_chars(const char* first, const char* last, IPv4& ip) {
+        std::uint32_t address = 0;
+        const char* p = first;
+        for (int i = 0; i < 4; ++i) {
+            if (i > 0) {
+                if (p == last || *p != '.') return {p, std::errc::invalid_argument};
+                ++p;
+            }
+            const char* start = p;
+            unsigned octet = 0;
+            while (p != last && static_cast<unsigned>(*p - '0') <= 9 && p - start < 3) {
+                octet = octet * 10 + static_cast<unsigned>(*p - '0');
+                ++p;
+            }
+            if (p == start) return {p, std::errc::invalid_argument};
+            if (p - start > 1 && *start == '0') return {start, std::errc::invalid_argument};
+            if (octet > 255 || (p != last && static_cast<unsigned>(*p - '0') <= 9)) {
+                return {start, std::errc::result_out_of_range};
+            }
+            address = address << 8 | octet;
+        }
+        ip.value = address;
+        return {p, std::errc{}};
+    }
+
+    // То же, но за одну загрузку 16 байт (адрес занимает не больше 15 символов).
+    // Любой подозрительный случай уходит в скалярный разбор, он же дает позицию ошибки
+    friend std::from_chars_result from_chars_simd(const char* first, const char* last, IPv4& ip) {
+#if defined(__SSSE3__)
+        __m128i chars;
+        if (last - first >= 16) {
+            chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        } else {
+            alignas(16) char window[16] = {};
+            std::memcpy(window, first, static_cast<std::size_t>(last - first));
+            chars = _mm_load_si128(reinterpret_cast<const __m128i*>(window));
+        }
+        __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+        __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+        unsigned digitMask = static_cast<unsigned>(_mm_movemask_epi8(isDigit));
+        unsigned dotMask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('.'))));
+        unsigned terminators = ~(digitMask | dotMask) & 0xFFFFu;
+        int length = std::countr_zero(terminators | 0x10000u);
+        dotMask &= (1u << length) - 1;
+        if (length < 16 && std::popcount(dotMask) == 3) {
+            int dot0 = std::countr_zero(dotMask);
+            dotMask &= dotMask - 1;
+            int dot1 = std::countr_zero(dotMask);
+            dotMask &= dotMask - 1;
+            int dot2 = std::countr_zero(dotMask);
+            int lengths[4] = {dot0, dot1 - dot0 - 1, dot2 - dot1 - 1, length - dot2 - 1};
+            if (lengths[0] >= 1 && lengths[0] <= 3 && lengths[1] >= 1 && lengths[1] <= 3 &&
+                lengths[2] >= 1 && lengths[2] <= 3 && lengths[3] >= 1 && lengths[3] <= 3) {
+                const OctetShuffle& entry =
+                    octetShuffles[(lengths[0] - 1) * 27 + (lengths[1] - 1) * 9 + (lengths[2] - 1) * 3 + lengths[3] - 1];
+                unsigned zeroMask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('0'))));
+                __m128i lanes = _mm_shuffle_epi8(digits, _mm_load_si128(reinterpret_cast<const __m128i*>(entry.shuffle)));
+                __m128i pairs = _mm_maddubs_epi16(lanes, _mm_set1_epi32(0x00010A64)); // веса 100, 10, 1, 0
+                __m128i values = _mm_madd_epi16(pairs, _mm_set1_epi16(1));
+                bool overflow = _mm_movemask_epi8(_mm_cmpgt_epi32(values, _mm_set1_epi32(255))) != 0;
+                if (!overflow && (zeroMask & entry.leadingDigits) == 0) {
+                    // x86 little-endian: первый октет в старший байт
+                    __m128i packed = _mm_shuffle_epi8(values, _mm_setr_epi8(12, 8, 4, 0, -1, -1, -1, -1,
+                                                                            -1, -1, -1, -1, -1, -1, -1, -1));
+                    ip.value = static_cast<std::uint32_t>(_mm_cvtsi128_si32(packed));
+                    return {first + length, std::errc{}};
+                }
+            }
+        }
+#endif
+        return from_chars(first, last, ip);
+    }
+
+    // Строка должна целиком быть адресом; иначе nullopt и позиция ошибки
+    static std::optional<IPv4> parse(std::string_view text, std::size_t* errorPosition = nullptr) {
+        IPv4 ip;
+        auto [ptr, ec] = from_chars(text.data(), text.data() + text.size(), ip);
+        if (ec == std::errc{} && ptr == text.data() + text.size()) {
+            return ip;
+        }
+        if (errorPosition) {
+            *errorPosition = static_cast<std::size_t>(ptr - text.data());
+        }
+        return std::nullopt;
+    }
+    
+    friend std::to_chars_result to_chars(char* first, char* last, const IPv4& ip) {
+        if (last - first >= static_cast<std::ptrdiff_t>(bulkBytesPerAddress)) {
+            return {ip.writeText(first), std::errc{}};
+        }
+        char buffer[bulkBytesPerAddress];
+        std::size_t length = static_cast<std::size_t>(ip.writeText(buffer) - buffer);
+        if (length > static_cast<std::size_t>(last - first)) {
+            return {last, std::errc::value_too_large};
+        }
+        std::memcpy(first, buffer, length);
+        return {first + length, std::errc{}};
+    }
+
+    // Адреса подряд через separator; в out должно быть addresses.size() * bulkBytesPerAddress байт
+    static char* formatBulk(std::span<const IPv4> addresses, char* out, char separator = '\n') {
+        for (const IPv4& ip : addresses) {
+            out = ip.writeText(out);
+            *out++ = separator;
+        }
+        return out;
+    }
+
+    static void formatBulk(std::span<const IPv4> addresses, std::string& out, char separator = '\n') {
+        std::size_t offset = out.size();
+        out.resize(offset + addresses.size() * bulkBytesPerAddress);
+        char* end = formatBulk(addresses, out.data() + offset, separator);
+        out.resize(static_cast<std::size_t>(end - out.data()));
+    }
+
+    friend std::stringstream& operator<<(std::stringstream& ss, const IPv4& ip) {
+        ss << static_cast<int>(ip.octet(0)) << '.' 
+           << static_cast<int>(ip.octet(1)) << '.' 
+           << static_cast<int>(ip.octet(2)) << '.' 
+           << static_cast<int>(ip.octet(3));
+        return ss;
+    }
+    
+    friend std::stringstream& operator>>(std::stringstream& ss, IPv4& ip) {
+        int a{}, b{}, c{}, d{};
+        char dot1{}, dot2{}, dot3{};
+        
+        ss >> a >> dot1 >> b >> dot2 >> c >> dot3 >> d;
+        
+        if (dot1 != '.' || dot2 != '.' || dot3 != '.' ||
+            a < 0 || a > 255 || b < 0 || b > 255 || 
+            c < 0 || c > 255 || d < 0 || d > 255) {
+            ss.setstate(std::ios::failbit);
+            return ss;
+        }
+        
+        ip = IPv4(static_cast<std::uint8_t>(a), static_cast<std::uint8_t>(b),
+                  static_cast<std::uint8_t>(c), static_cast<std::uint8_t>(d));
+        
+        return ss;
+    }
+};
+
+// Перемешивание битов (lowbias32): у соседних адресов хэши не соседние
+template<>
+struct std::hash<IPv4> {
+    std::size_t operator()(const IPv4& ip) const noexcept {
+        std::uint32_t x = ip.toUint32();
+        x ^= x >> 16;
+        x *= 0x7feb352dU;
+        x ^= x >> 15;
+        x *= 0x846ca68bU;
+        x ^= x >> 16;
+        return x;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Префиксы CIDR и таблица поиска самого длинного совпадающего префикса
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Префикс "адрес/длина" для IPv4 и IPv6. От Address нужны bitCount, maskedTo, withHostBits,
+// сравнения и from_chars/to_chars
+template<typename Address>
+class BasicPrefix {
+private:
+    Address base;
+    std::uint8_t bits;
+
+    // длина проверяется до maskedTo: сдвиг на отрицательную или слишком большую величину - UB;
+    // в release-сборке недопустимая длина зажимается в [0, bitCount]
+    static constexpr int checkedLength(int length) {
+        assert(length >= 0 && length <= Address::bitCount);
+        return std::clamp(length, 0, Address::bitCount);
+    }
+
+public:
+    static constexpr std::size_t maxTextLength = Address::maxTextLength + 4;
+
+    constexpr BasicPrefix() : bits(0) {}
+
+    // биты хоста отбрасываются: 10.1.2.3/8 становится 10.0.0.0/8
+    constexpr BasicPrefix(Address address, int length)
+        : base(address.maskedTo(checkedLength(length))), bits(static_cast<std::uint8_t>(checkedLength(length))) {}
+
+    constexpr int length() const { return bits; }
+    constexpr Address network() const { return base; }
+    constexpr Address lastAddress() const { return base.withHostBits(bits); }
+
+    constexpr bool contains(Address address) const {
+        return address.maskedTo(bits) == base;
+    }
+
+    constexpr bool contains(const BasicPrefix& other) const {
+        return other.bits >= bits && contains(other.base);
+    }
+
+    constexpr Address broadcast() const requires (Address::bitCount == 32) { return lastAddress(); }
+
+    constexpr std::uint32_t mask() const requires (Address::bitCount == 32) {
+        return Address(~std::uint32_t(0)).maskedTo(bits).toUint32();
+    }
+
+    constexpr std::uint64_t size() const requires (Address::bitCount == 32) {
+        return std::uint64_t(1) << (32 - bits);
+    }
+
+    friend bool operator==(const BasicPrefix& lhs, const BasicPrefix& rhs) {
+        return lhs.base == rhs.base && lhs.bits == rhs.bits;
+    }
+
+    friend bool operator!=(const BasicPrefix& lhs, const BasicPrefix& rhs) {
+        return !(lhs == rhs);
+    }
+
+    // сначала по сети, при равной сети короткий префикс раньше
+    friend bool operator<(const BasicPrefix& lhs, const BasicPrefix& rhs) {
+        return lhs.base != rhs.base ? lhs.base < rhs.base : lhs.bits < rhs.bits;
+    }
+
+    // "адрес/длина", длина без ведущих нулей и не больше Address::bitCount
+    friend std::from_chars_result from_chars(const char* first, const char* last, BasicPrefix& prefix) {
+        Address address;
+        auto result = from_chars(first, last, address);
+        if (result.ec != std::errc{}) return result;
+        const char* p = result.ptr;
+        if (p == last || *p != '/') return {p, std::errc::invalid_argument};
+        const char* start = ++p;
+        int length = 0;
+        while (p != last && static_cast<unsigned>(*p - '0') <= 9 && p - start < 3) {
+            length = length * 10 + (*p - '0');
+            ++p;
+        }
+        if (p == start) return {p, std::errc::invalid_argument};
+        if (p - start > 1 && *start == '0') return {start, std::errc::invalid_argument};
+        if (length > Address::bitCount || (p != last && static_cast<unsigned>(*p - '0') <= 9)) {
+            return {start, std::errc::result_out_of_range};
+        }
+        prefix = BasicPrefix(address, length);
+        return {p, std::errc{}};
+    }
+
+    static std::optional<BasicPrefix> parse(std::string_view text, std::size_t* errorPosition = nullptr) {
+        BasicPrefix prefix;
+        auto [ptr, ec] = from_chars(text.data(), text.data() + text.size(), prefix);
+        if (ec == std::errc{} && ptr == text.data() + text.size()) {
+            return prefix;
+        }
+        if (errorPosition) {
+            *errorPosition = static_cast<std::size_t>(ptr - text.data());
+        }
+        return std::nullopt;
+    }
+
+    friend std::to_chars_result to_chars(char* first, char* last, const BasicPrefix& prefix) {
+        auto result = to_chars(first, last, prefix.base);
+        if (result.ec != std::errc{}) return result;
+        const OctetText& length = octetTexts[prefix.bits];
+        if (last - result.ptr < 1 + length.length) return {last, std::errc::value_too_large};
+        char* out = result.ptr;
+        *out++ = '/';
+        std::memcpy(out, length.digits, length.length);
+        return {out + length.length, std::errc{}};
+    }
+
+    friend std::stringstream& operator<<(std::stringstream& ss, const BasicPrefix& prefix) {
+        char buffer[maxTextLength];
+        auto result = to_chars(buffer, buffer + sizeof(buffer), prefix);
+        ss.write(buffer, result.ptr - buffer);
+        return ss;
+    }
+};
+
+using IPv4Prefix = BasicPrefix<IPv4>;
+
+struct IPv4Route {
+    IPv4Prefix prefix;
+    std::uint32_t nextHop;
+};
+
+// DIR-24-8: по старшим 24 битам адреса одна ячейка (64 МБ на все 2^24), для префиксов
+// длиннее /24 ячейка ссылается на группу из 256 записей по младшему октету.
+// Поиск - одно чтение, для длинных префиксов два
+class IPv4LpmTable {
+private:
+    static constexpr std::uint32_t groupFlag = 0x80000000u;
+
+    std::vector<std::uint32_t> level24;
+    std::vector<std::uint32_t> level8;
+
+public:
+    static constexpr std::uint32_t noRoute = 0x7FFFFFFFu;
+
+    // при одинаковых префиксах побеждает последний маршрут
+    explicit IPv4LpmTable(std::span<const IPv4Route> routes) : level24(std::size_t(1) << 24, noRoute) {
+        std::vector<IPv4Route> sorted(routes.begin(), routes.end());
+        // короткие префиксы раньше: длинные потом перезаписывают их ячейки
+        std::stable_sort(sorted.begin(), sorted.end(), [](const IPv4Route& lhs, const IPv4Route& rhs) {
+            return lhs.prefix.length() < rhs.prefix.length();
+        });
+        for (const IPv4Route& route : sorted) {
+            assert(route.nextHop < noRoute);
+            std::uint32_t network = route.prefix.network().toUint32();
+            int length = route.prefix.length();
+            if (length <= 24) {
+                std::fill_n(level24.begin() + (network >> 8), std::size_t(1) << (24 - length), route.nextHop);
+                continue;
+            }
+            std::uint32_t& slot = level24[network >> 8];
+            if (!(slot & groupFlag)) {
+                std::uint32_t group = static_cast<std::uint32_t>(level8.size() / 256);
+                level8.resize(level8.size() + 256, slot);
+                slot = groupFlag | group;
+            }
+            std::size_t first = (slot & ~groupFlag) * std::size_t(256) + (network & 0xFF);
+            std::fill_n(level8.begin() + first, std::size_t(1) << (32 - length), route.nextHop);
+        }
+    }
+
+    std::uint32_t lookup(IPv4 address) const {
+        std::uint32_t value = address.toUint32();
+        std::uint32_t entry = level24[value >> 8];
+        if (entry & groupFlag) {
+            entry = level8[(entry & ~groupFlag) * std::size_t(256) + (value & 0xFF)];
+        }
+        return entry;
+    }
+
+    // Пачками по 16: сначала все независимые чтения первого уровня, потом второго,
+    // чтобы промахи кэша шли параллельно
+    void lookup(std::span<const IPv4> addresses, std::span<std::uint32_t> nextHops) const {
+        assert(nextHops.size() >= addresses.size());
+        constexpr std::size_t batch = 16;
+        std::size_t i = 0;
+        for (; i + batch <= addresses.size(); i += batch) {
+            std::uint32_t entries[batch];
+            for (std::size_t j = 0; j < batch; ++j) {
+                entries[j] = level24[addresses[i + j].toUint32() >> 8];
+            }
+            for (std::size_t j = 0; j < batch; ++j) {
+                if (entries[j] & groupFlag) {
+                    entries[j] = level8[(entries[j] & ~groupFlag) * std::size_t(256) + (addresses[i + j].toUint32() & 0xFF)];
+                }
+                nextHops[i + j] = entries[j];
+            }
+        }
+        for (; i < addresses.size(); ++i) {
+            nextHops[i] = lookup(addresses[i]);
+        }
+    }
+
+    std::size_t groups() const { return level8.size() / 256; }
+
+    std::size_t memoryBytes() const {
+        return (level24.capacity() + level8.capacity()) * sizeof(std::uint32_t);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Множество диапазонов адресов для списков разрешений и запретов
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Замкнутый диапазон [first, last]
+struct IPv4Interval {
+    IPv4 first;
+    IPv4 last;
+
+    IPv4Interval(IPv4 address) : first(address), last(address) {}
+
+    IPv4Interval(IPv4 from, IPv4 to) : first(from), last(to) {
+        assert(from <= to);
+    }
+
+    IPv4Interval(const IPv4Prefix& prefix) : first(prefix.network()), last(prefix.broadcast()) {}
+
+    friend bool operator==(const IPv4Interval& lhs, const IPv4Interval& rhs) {
+        return lhs.first == rhs.first && lhs.last == rhs.last;
+    }
+};
+
+// Диапазоны хранятся отсортированными, без пересечений и без стыков: соседние сливаются.
+// Поиск идет по массиву начал бинарным поиском без ветвлений либо по тому же массиву
+// в порядке Эйтцингера (дерево в массиве, как у кучи): верхние уровни всегда в кэше
+class IPv4RangeSet {
+public:
+    enum class Layout { Sorted, Eytzinger };
+
+private:
+    // в вершине дерева рядом с началом лежит конец предыдущего по порядку диапазона
+    struct EytzingerNode {
+        std::uint32_t start;
+        std::uint32_t previousEnd;
+    };
+
+    std::vector<std::uint32_t> starts;
+    std::vector<std::uint32_t> ends;
+    std::vector<EytzingerNode> tree;
+    Layout layout = Layout::Sorted;
+
+    void push(std::uint32_t first, std::uint32_t last) {
+        if (!ends.empty() && std::uint64_t(ends.back()) + 1 >= first) {
+            ends.back() = std::max(ends.back(), last);
+            return;
+        }
+        starts.push_back(first);
+        ends.push_back(last);
+    }
+
+    std::size_t fillTree(std::size_t index, std::size_t node) {
+        if (node >= tree.size()) return index;
+        index = fillTree(index, 2 * node);
+        tree[node] = {starts[index], index > 0 ? ends[index - 1] : 0};
+        return fillTree(index + 1, 2 * node + 1);
+    }
+
+    void rebuildIndex() {
+        tree.clear();
+        if (layout == Layout::Eytzinger) {
+            tree.resize(starts.size() + 1);
+            fillTree(0, 1);
+        }
+    }
+
+    bool containsSorted(std::uint32_t value) const {
+        const std::uint32_t* base = starts.data();
+        std::size_t count = starts.size();
+        // последнее начало не больше value; сравнение превращается в cmov
+        while (count > 1) {
+            std::size_t half = count / 2;
+            base = base[half] <= value ? base + half : base;
+            count -= half;
+        }
+        return value <= ends[static_cast<std::size_t>(base - starts.data())];
+    }
+
+    bool containsEytzinger(std::uint32_t value) const {
+        std::size_t node = 1;
+        std::size_t count = starts.size();
+        while (node <= count) {
+#if defined(__GNUC__)
+            __builtin_prefetch(tree.data() + std::min(16 * node, count));
+#endif
+            node = 2 * node + (tree[node].start <= value);
+        }
+        // снимаем хвост из единиц: остается вершина первого начала больше value
+        node >>= std::countr_one(node) + 1;
+        return value <= (node == 0 ? ends.back() : tree[node].previousEnd);
+    }
+
+public:
+    IPv4RangeSet() = default;
+
+    explicit IPv4RangeSet(std::span<const IPv4Interval> intervals, Layout searchLayout = Layout::Sorted)
+        : layout(searchLayout) {
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> sorted;
+        sorted.reserve(intervals.size());
+        for (const IPv4Interval& interval : intervals) {
+            sorted.emplace_back(interval.first.toUint32(), interval.last.toUint32());
+        }
+        std::sort(sorted.begin(), sorted.end());
+        starts.reserve(sorted.size());
+        ends.reserve(sorted.size());
+        for (const auto& [first, last] : sorted) {
+            push(first, last);
+        }
+        rebuildIndex();
+    }
+
+    // Вставка одного диапазона за O(n); много диапазонов быстрее собрать конструктором
+    void insert(const IPv4Interval& interval) {
+        std::uint32_t first = interval.first.toUint32();
+        std::uint32_t last = interval.last.toUint32();
+        // диапазоны, которые пересекаются с новым или примыкают к нему
+        auto from = std::lower_bound(ends.begin(), ends.end(), first, [](std::uint32_t end, std::uint32_t value) {
+            return std::uint64_t(end) + 1 < value;
+        });
+        std::size_t begin = static_cast<std::size_t>(from - ends.begin());
+        std::size_t stop = begin;
+        while (stop < starts.size() && starts[stop] <= std::uint64_t(last) + 1) {
+            ++stop;
+        }
+        if (begin < stop) {
+            first = std::min(first, starts[begin]);
+            last = std::max(last, ends[stop - 1]);
+            starts.erase(starts.begin() + static_cast<std::ptrdiff_t>(begin + 1), starts.begin() + static_cast<std::ptrdiff_t>(stop));
+            ends.erase(ends.begin() + static_cast<std::ptrdiff_t>(begin + 1), ends.begin() + static_cast<std::ptrdiff_t>(stop));
+            starts[begin] = first;
+            ends[begin] = last;
+        } else {
+            starts.insert(starts.begin() + static_cast<std::ptrdiff_t>(begin), first);
+            ends.insert(ends.begin() + static_cast<std::ptrdiff_t>(begin), last);
+        }
+        rebuildIndex();
+    }
+
+    void setLayout(Layout searchLayout) {
+        layout = searchLayout;
+        rebuildIndex();
+    }
+
+    bool contains(IPv4 address) const {
+        std::uint32_t value = address.toUint32();
+        if (starts.empty() || value < starts.front()) return false;
+        return layout == Layout::Eytzinger ? containsEytzinger(value) : containsSorted(value);
+    }
+
+    std::size_t size() const { return starts.size(); }
+    bool empty() const { return starts.empty(); }
+
+    std::uint64_t addressCount() const {
+        std::uint64_t count = 0;
+        for (std::size_t i = 0; i < starts.size(); ++i) {
+            count += std::uint64_t(ends[i]) - starts[i] + 1;
+        }
+        return count;
+    }
+
+    std::vector<IPv4Interval> intervals() const {
+        std::vector<IPv4Interval> result;
+        result.reserve(starts.size());
+        for (std::size_t i = 0; i < starts.size(); ++i) {
+            result.emplace_back(IPv4(starts[i]), IPv4(ends[i]));
+        }
+        return result;
+    }
+
+    friend bool operator==(const IPv4RangeSet& lhs, const IPv4RangeSet& rhs) {
+        return lhs.starts == rhs.starts && lhs.ends == rhs.ends;
+    }
+
+    friend bool operator!=(const IPv4RangeSet& lhs, const IPv4RangeSet& rhs) {
+        return !(lhs == rhs);
+    }
+
+    // Операции линейны по числу диапазонов; результат берет раскладку левого операнда
+    friend IPv4RangeSet operator|(const IPv4RangeSet& lhs, const IPv4RangeSet& rhs) {
+        IPv4RangeSet result;
+        result.layout = lhs.layout;
+        std::size_t i = 0, j = 0;
+        while (i < lhs.size() || j < rhs.size()) {
+            if (j == rhs.size() || (i < lhs.size() && lhs.starts[i] <= rhs.starts[j])) {
+                result.push(lhs.starts[i], lhs.ends[i]);
+                ++i;
+            } else {
+                result.push(rhs.starts[j], rhs.ends[j]);
+                ++j;
+            }
+        }
+        result.rebuildIndex();
+        return result;
+    }
+
+    friend IPv4RangeSet operator&(const IPv4RangeSet& lhs, const IPv4RangeSet& rhs) {
+        IPv4RangeSet result;
+        result.layout = lhs.layout;
+        std::size_t i = 0, j = 0;
+        while (i < lhs.size() && j < rhs.size()) {
+            std::uint32_t first = std::max(lhs.starts[i], rhs.starts[j]);
+            std::uint32_t last = std::min(lhs.ends[i], rhs.ends[j]);
+            if (first <= last) {
+                result.starts.push_back(first);
+                result.ends.push_back(last);
+            }
+            if (lhs.ends[i] < rhs.ends[j]) {
+                ++i;
+            } else {
+                ++j;
+            }
+        }
+        result.rebuildIndex();
+        return result;
+    }
+
+    friend IPv4RangeSet operator-(const IPv4RangeSet& lhs, const IPv4RangeSet& rhs) {
+        IPv4RangeSet result;
+        result.layout = lhs.layout;
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            std::uint64_t current = lhs.starts[i];
+            while (j < rhs.size() && rhs.ends[j] < current) {
+                ++j;
+            }
+            // вычитаемый диапазон может задеть и следующий диапазон слева, поэтому j не сдвигаем
+            for (std::size_t k = j; k < rhs.size() && rhs.starts[k] <= lhs.ends[i]; ++k) {
+                if (rhs.starts[k] > current) {
+                    result.starts.push_back(static_cast<std::uint32_t>(current));
+                    result.ends.push_back(rhs.starts[k] - 1);
+                }
+                current = std::max<std::uint64_t>(current, std::uint64_t(rhs.ends[k]) + 1);
+            }
+            if (current <= lhs.ends[i]) {
+                result.starts.push_back(static_cast<std::uint32_t>(current));
+                result.ends.push_back(lhs.ends[i]);
+            }
+        }
+        result.rebuildIndex();
+        return result;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Подсчет адресов в журналах: файл отображается в память, режется по границам строк
+// между потоками, каждый поток разбирает адреса быстрым разбором в свой счетчик
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Открытая адресация с линейным пробированием; 0 означает пустую ячейку, сам адрес 0.0.0.0 учитывается отдельно
+class AddressHashSet {
+private:
+    std::vector<std::uint32_t> slots;
+    std::size_t count = 0;
+    bool hasZero = false;
+
+    void grow() {
+        std::vector<std::uint32_t> old(slots.size() * 2);
+        old.swap(slots);
+        for (std::uint32_t value : old) {
+            if (value != 0) place(value);
+        }
+    }
+
+    bool place(std::uint32_t value) {
+        std::size_t mask = slots.size() - 1;
+        std::size_t index = std::hash<IPv4>()(IPv4(value)) & mask;
+        while (slots[index] != 0) {
+            if (slots[index] == value) return false;
+            index = (index + 1) & mask;
+        }
+        slots[index] = value;
+        return true;
+    }
+
+public:
+    AddressHashSet() : slots(1024) {}
+
+    bool insert(IPv4 address) {
+        std::uint32_t value = address.toUint32();
+        if (value == 0) {
+            bool added = !hasZero;
+            hasZero = true;
+            count += added;
+            return added;
+        }
+        // заполнение не больше половины
+        if ((count + 1) * 2 > slots.size()) {
+            grow();
+        }
+        bool added = place(value);
+        count += added;
+        return added;
+    }
+
+    void merge(const AddressHashSet& other) {
+        if (other.hasZero) insert(IPv4());
+        for (std::uint32_t value : other.slots) {
+            if (value != 0) insert(IPv4(value));
+        }
+    }
+
+    std::size_t size() const { return count; }
+};
+
+// Отображение файла журнала только для чтения
+class MappedLogFile {
+private:
+    const char* base = nullptr;
+    std::size_t length = 0;
+#if defined(_WIN32)
+    std::string fallbackStorage;
+#endif
+
+public:
+    MappedLogFile() = default;
+    MappedLogFile(const MappedLogFile&) = delete;
+    MappedLogFile& operator=(const MappedLogFile&) = delete;
+
+    ~MappedLogFile() {
+#if !defined(_WIN32)
+        if (base != nullptr && length > 0) {
+            munmap(const_cast<char*>(base), length);
+        }
+#endif
+    }
+
+    bool open(const std::filesystem::path& path) {
+#if !defined(_WIN32)
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) return false;
+        struct stat info;
+        if (fstat(descriptor, &info) != 0) {
+            close(descriptor);
+            return false;
+        }
+        length = static_cast<std::size_t>(info.st_size);
+        if (length == 0) {
+            close(descriptor);
+            base = "";
+            return true;
+        }
+        void* memory = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+        if (memory == MAP_FAILED) {
+            length = 0;
+            return false;
+        }
+        // читаем один раз подряд: ядру стоит читать вперед крупно
+        madvise(memory, length, MADV_SEQUENTIAL);
+        base = static_cast<const char*>(memory);
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        fallbackStorage.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        base = fallbackStorage.data();
+        length = fallbackStorage.size();
+#endif
+        return true;
+    }
+
+    std::string_view text() const { return {base, length}; }
+};
+
+struct LogScanOptions {
+    enum class Counting { HashSet, Bitmap };
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    // только адрес в начале строки (клиент в access.log), иначе все адреса в строке
+    bool firstFieldOnly = false;
+    // HashSet: свой набор у каждого потока, объединение в конце.
+    // Bitmap: общая битовая карта на все 2^32 адресов (512 МБ), биты ставятся атомарно
+    Counting counting = Counting::HashSet;
+};
+
+struct LogScanResult {
+    std::uint64_t bytes = 0;
+    std::uint64_t lines = 0;
+    std::uint64_t addresses = 0;
+    std::uint64_t distinct = 0;
+    long long microseconds = 0;
+
+    double gigabytesPerSecond() const {
+        return static_cast<double>(bytes) / (static_cast<double>(microseconds) + 1) / 1e3;
+    }
+};
+
+inline bool isAddressChar(char c) {
+    return static_cast<unsigned>(c - '0') <= 9 || c == '.';
+}
+
+// Разбирает строки [begin, end); limit - конец всего текста, до него разрешено читать
+template<typename Sink>
+std::uint64_t extractAddresses(const char* begin, const char* end, const char* limit, bool firstFieldOnly, Sink&& sink) {
+    std::uint64_t lines = 0;
+    IPv4 ip;
+    if (firstFieldOnly) {
+        for (const char* p = begin; p < end;) {
+            auto result = from_chars_simd(p, limit, ip);
+            if (result.ec == std::errc{} && (result.ptr == limit || !isAddressChar(*result.ptr))) {
+                sink(ip);
+            }
+            const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+            if (newline == nullptr) break;
+            ++lines;
+            p = newline + 1;
+        }
+        return lines;
+    }
+    for (const char* p = begin; p < end;) {
+        char c = *p;
+        if (c == '\n') {
+            ++lines;
+            ++p;
+        } else if (static_cast<unsigned>(c - '0') <= 9) {
+            // сюда попадаем только в начале серии цифр и точек: "1.2.3.4.5" целиком не адрес
+            auto result = from_chars_simd(p, limit, ip);
+            const char* next = p;
+            if (result.ec == std::errc{}) {
+                next = result.ptr;
+                if (next == limit || !isAddressChar(*next)) sink(ip);
+            }
+            while (next < limit && isAddressChar(*next)) ++next;
+            p = next;
+        } else {
+            ++p;
+        }
+    }
+    return lines;
+}
+
+LogScanResult scanLog(std::string_view text, const LogScanOptions& options) {
+    LogScanResult result;
+    result.bytes = text.size();
+    auto start = std::chrono::steady_clock::now();
+
+    unsigned threadCount = std::max(1u, options.threads);
+    const char* data = text.data();
+    const char* limit = data + text.size();
+    // границы кусков сдвигаются вперед до начала следующей строки
+    std::vector<const char*> bounds(threadCount + 1, limit);
+    bounds[0] = data;
+    for (unsigned i = 1; i < threadCount; ++i) {
+        const char* guess = std::max(bounds[i - 1], data + text.size() * i / threadCount);
+        const char* newline = static_cast<const char*>(std::memchr(guess, '\n', static_cast<std::size_t>(limit - guess)));
+        bounds[i] = newline ? newline + 1 : limit;
+    }
+
+    struct alignas(64) ThreadCounts {
+        std::uint64_t lines = 0;
+        std::uint64_t addresses = 0;
+        AddressHashSet seen;
+    };
+    std::vector<ThreadCounts> counts(threadCount);
+    bool useBitmap = options.counting == LogScanOptions::Counting::Bitmap;
+    std::vector<std::uint64_t> bitmap(useBitmap ? (std::size_t(1) << 32) / 64 : 0);
+
+    auto work = [&](unsigned index) {
+        ThreadCounts& local = counts[index];
+        local.lines = extractAddresses(bounds[index], bounds[index + 1], limit, options.firstFieldOnly, [&](IPv4 ip) {
+            ++local.addresses;
+            if (useBitmap) {
+                std::uint32_t value = ip.toUint32();
+                std::atomic_ref<std::uint64_t> word(bitmap[value >> 6]);
+                std::uint64_t bit = std::uint64_t(1) << (value & 63);
+                // частые клиенты повторяются: атомарная запись только для нового бита
+                if (!(word.load(std::memory_order_relaxed) & bit)) {
+                    word.fetch_or(bit, std::memory_order_relaxed);
+                }
+            } else {
+                local.seen.insert(ip);
+            }
+        });
+    };
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadCount; ++i) {
+        threads.emplace_back(work, i);
+    }
+    work(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (const ThreadCounts& local : counts) {
+        result.lines += local.lines;
+        result.addresses += local.addresses;
+    }
+    if (!text.empty() && text.back() != '\n') {
+        ++result.lines;
+    }
+    if (useBitmap) {
+        for (std::uint64_t word : bitmap) {
+            result.distinct += static_cast<std::uint64_t>(std::popcount(word));
+        }
+    } else {
+        auto largest = std::max_element(counts.begin(), counts.end(), [](const ThreadCounts& lhs, const ThreadCounts& rhs) {
+            return lhs.seen.size() < rhs.seen.size();
+        });
+        for (const ThreadCounts& local : counts) {
+            if (&local != &*largest) largest->seen.merge(local.seen);
+        }
+        result.distinct = largest->seen.size();
+    }
+    result.microseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+std::optional<LogScanResult> scanLogFile(const std::filesystem::path& path, const LogScanOptions& options) {
+    MappedLogFile file;
+    if (!file.open(path)) return std::nullopt;
+    return scanLog(file.text(), options);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Перебор диапазона адресов и компактное множество адресов в стиле roaring bitmap
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Замкнутый диапазон адресов как представление с итераторами произвольного доступа.
+// Позиция хранится в 64 битах, поэтому 255.255.255.255 перебирается без переполнения
+class IPv4Range : public std::ranges::view_interface<IPv4Range> {
+private:
+    std::uint64_t first = 0;
+    std::uint64_t stop = 0;
+
+public:
+    class Iterator {
+    private:
+        std::uint64_t position = 0;
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag; // разыменование дает значение, как у iota_view
+        using value_type = IPv4;
+        using difference_type = std::int64_t;
+
+        Iterator() = default;
+        explicit Iterator(std::uint64_t start) : position(start) {}
+
+        IPv4 operator*() const { return IPv4(static_cast<std::uint32_t>(position)); }
+        IPv4 operator[](difference_type offset) const { return *(*this + offset); }
+
+        Iterator& operator++() { ++position; return *this; }
+        Iterator operator++(int) { Iterator temp = *this; ++position; return temp; }
+        Iterator& operator--() { --position; return *this; }
+        Iterator operator--(int) { Iterator temp = *this; --position; return temp; }
+
+        Iterator& operator+=(difference_type offset) {
+            position += static_cast<std::uint64_t>(offset);
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type offset) {
+            position -= static_cast<std::uint64_t>(offset);
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type offset) { return it += offset; }
+        friend Iterator operator+(difference_type offset, Iterator it) { return it += offset; }
+        friend Iterator operator-(Iterator it, difference_type offset) { return it -= offset; }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) {
+            return static_cast<difference_type>(lhs.position) - static_cast<difference_type>(rhs.position);
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) = default;
+        friend auto operator<=>(const Iterator& lhs, const Iterator& rhs) = default;
+    };
+
+    IPv4Range() = default;
+
+    IPv4Range(IPv4 from, IPv4 to) : first(from.toUint32()), stop(std::uint64_t(to.toUint32()) + 1) {
+        assert(from <= to);
+    }
+
+    IPv4Range(const IPv4Prefix& prefix) : IPv4Range(prefix.network(), prefix.broadcast()) {}
+    IPv4Range(const IPv4Interval& interval) : IPv4Range(interval.first, interval.last) {}
+
+    Iterator begin() const { return Iterator(first); }
+    Iterator end() const { return Iterator(stop); }
+    std::uint64_t size() const { return stop - first; }
+
+    bool contains(IPv4 address) const {
+        return address.toUint32() >= first && address.toUint32() < stop;
+    }
+};
+
+// Старшие 16 бит адреса выбирают контейнер, младшие 16 лежат в нем: до 4096 значений -
+// отсортированный массив uint16 (2 байта на адрес), больше - битовая карта на 8 КБ.
+// Контейнеров серий, как в настоящем roaring, нет: диапазоны ложатся в карты словами
+class IPv4Set {
+private:
+    static constexpr std::size_t arrayLimit = 4096;
+    static constexpr std::size_t bitmapWords = 65536 / 64;
+
+    struct Container {
+        std::uint16_t key = 0;
+        std::uint32_t cardinality = 0;
+        std::vector<std::uint16_t> array;
+        std::vector<std::uint64_t> bits;
+
+        bool isBitmap() const { return !bits.empty(); }
+
+        bool contains(std::uint16_t low) const {
+            if (isBitmap()) return bits[low >> 6] >> (low & 63) & 1;
+            return std::binary_search(array.begin(), array.end(), low);
+        }
+
+        void toBitmap() {
+            bits.assign(bitmapWords, 0);
+            for (std::uint16_t low : array) {
+                bits[low >> 6] |= std::uint64_t(1) << (low & 63);
+            }
+            array.clear();
+            array.shrink_to_fit();
+        }
+
+        // после удаления и пересечения: малые карты обратно в массив
+        void compact() {
+            if (!isBitmap() || cardinality > arrayLimit) return;
+            array.clear();
+            array.reserve(cardinality);
+            forEach([&](std::uint16_t low) { array.push_back(low); });
+            bits.clear();
+            bits.shrink_to_fit();
+        }
+
+        template<typename F>
+        void forEach(F&& function) const {
+            if (!isBitmap()) {
+                for (std::uint16_t low : array) function(low);
+                return;
+            }
+            for (std::size_t word = 0; word < bitmapWords; ++word) {
+                for (std::uint64_t value = bits[word]; value != 0; value &= value - 1) {
+                    function(static_cast<std::uint16_t>(word * 64 + static_cast<std::size_t>(std::countr_zero(value))));
+                }
+            }
+        }
+    };
+
+    std::vector<Container> containers;
+
+    Container& containerFor(std::uint16_t key) {
+        auto it = std::lower_bound(containers.begin(), containers.end(), key,
+                                   [](const Container& container, std::uint16_t value) { return container.key < value; });
+        if (it == containers.end() || it->key != key) {
+            it = containers.insert(it, Container{});
+            it->key = key;
+        }
+        return *it;
+    }
+
+    const Container* findContainer(std::uint16_t key) const {
+        auto it = std::lower_bound(containers.begin(), containers.end(), key,
+                                   [](const Container& container, std::uint16_t value) { return container.key < value; });
+        return it != containers.end() && it->key == key ? &*it : nullptr;
+    }
+
+    static Container unite(const Container& lhs, const Container& rhs) {
+        Container result;
+        result.key = lhs.key;
+        if (!lhs.isBitmap() && !rhs.isBitmap()) {
+            result.array.reserve(lhs.array.size() + rhs.array.size());
+            std::set_union(lhs.array.begin(), lhs.array.end(), rhs.array.begin(), rhs.array.end(),
+                           std::back_inserter(result.array));
+            result.cardinality = static_cast<std::uint32_t>(result.array.size());
+            if (result.cardinality > arrayLimit) result.toBitmap();
+            return result;
+        }
+        const Container& bitmap = lhs.isBitmap() ? lhs : rhs;
+        const Container& other = lhs.isBitmap() ? rhs : lhs;
+        result.bits = bitmap.bits;
+        if (other.isBitmap()) {
+            for (std::size_t i = 0; i < bitmapWords; ++i) result.bits[i] |= other.bits[i];
+        } else {
+            for (std::uint16_t low : other.array) result.bits[low >> 6] |= std::uint64_t(1) << (low & 63);
+        }
+        for (std::uint64_t word : result.bits) result.cardinality += static_cast<std::uint32_t>(std::popcount(word));
+        return result;
+    }
+
+    static Container intersect(const Container& lhs, const Container& rhs) {
+        Container result;
+        result.key = lhs.key;
+        if (lhs.isBitmap() && rhs.isBitmap()) {
+            result.bits.resize(bitmapWords);
+            for (std::size_t i = 0; i < bitmapWords; ++i) {
+                result.bits[i] = lhs.bits[i] & rhs.bits[i];
+                result.cardinality += static_cast<std::uint32_t>(std::popcount(result.bits[i]));
+            }
+            result.compact();
+            return result;
+        }
+        if (!lhs.isBitmap() && !rhs.isBitmap()) {
+            std::set_intersection(lhs.array.begin(), lhs.array.end(), rhs.array.begin(), rhs.array.end(),
+                                  std::back_inserter(result.array));
+        } else {
+            const Container& array = lhs.isBitmap() ? rhs : lhs;
+            const Container& bitmap = lhs.isBitmap() ? lhs : rhs;
+            for (std::uint16_t low : array.array) {
+                if (bitmap.contains(low)) result.array.push_back(low);
+            }
+        }
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+        return result;
+    }
+
+    static Container subtract(const Container& lhs, const Container& rhs) {
+        Container result;
+        result.key = lhs.key;
+        if (!lhs.isBitmap()) {
+            for (std::uint16_t low : lhs.array) {
+                if (!rhs.contains(low)) result.array.push_back(low);
+            }
+            result.cardinality = static_cast<std::uint32_t>(result.array.size());
+            return result;
+        }
+        result.bits = lhs.bits;
+        if (rhs.isBitmap()) {
+            for (std::size_t i = 0; i < bitmapWords; ++i) result.bits[i] &= ~rhs.bits[i];
+        } else {
+            for (std::uint16_t low : rhs.array) result.bits[low >> 6] &= ~(std::uint64_t(1) << (low & 63));
+        }
+        for (std::uint64_t word : result.bits) result.cardinality += static_cast<std::uint32_t>(std::popcount(word));
+        result.compact();
+        return result;
+    }
+
+    void append(Container&& container) {
+        if (container.cardinality > 0) containers.push_back(std::move(container));
+    }
+
+public:
+    IPv4Set() = default;
+
+    // Сборка пачкой: сортировка и раскладка по контейнерам за один проход
+    explicit IPv4Set(std::span<const IPv4> addresses) {
+        std::vector<std::uint32_t> values;
+        values.reserve(addresses.size());
+        for (const IPv4& address : addresses) values.push_back(address.toUint32());
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        for (std::size_t i = 0; i < values.size();) {
+            std::size_t j = i;
+            std::uint32_t key = values[i] >> 16;
+            while (j < values.size() && values[j] >> 16 == key) ++j;
+            Container container;
+            container.key = static_cast<std::uint16_t>(key);
+            container.cardinality = static_cast<std::uint32_t>(j - i);
+            container.array.reserve(j - i);
+            for (std::size_t k = i; k < j; ++k) container.array.push_back(static_cast<std::uint16_t>(values[k]));
+            if (container.cardinality > arrayLimit) container.toBitmap();
+            containers.push_back(std::move(container));
+            i = j;
+        }
+    }
+
+    bool insert(IPv4 address) {
+        std::uint32_t value = address.toUint32();
+        Container& container = containerFor(static_cast<std::uint16_t>(value >> 16));
+        std::uint16_t low = static_cast<std::uint16_t>(value);
+        if (!container.isBitmap()) {
+            auto it = std::lower_bound(container.array.begin(), container.array.end(), low);
+            if (it != container.array.end() && *it == low) return false;
+            if (container.cardinality < arrayLimit) {
+                container.array.insert(it, low);
+                ++container.cardinality;
+                return true;
+            }
+            container.toBitmap();
+        }
+        std::uint64_t& word = container.bits[low >> 6];
+        std::uint64_t bit = std::uint64_t(1) << (low & 63);
+        if (word & bit) return false;
+        word |= bit;
+        ++container.cardinality;
+        return true;
+    }
+
+    // Целый диапазон: полные контейнеры заполняются словами, а не по одному адресу
+    void insert(const IPv4Range& range) {
+        if (range.empty()) return;
+        std::uint32_t first = (*range.begin()).toUint32();
+        std::uint32_t last = range.back().toUint32();
+        for (std::uint32_t key = first >> 16;; ++key) {
+            std::uint32_t low = key == first >> 16 ? first & 0xFFFF : 0;
+            std::uint32_t high = key == last >> 16 ? last & 0xFFFF : 0xFFFF;
+            Container& container = containerFor(static_cast<std::uint16_t>(key));
+            if (!container.isBitmap() && container.cardinality + (high - low + 1) <= arrayLimit) {
+                for (std::uint32_t v = low; v <= high; ++v) {
+                    auto it = std::lower_bound(container.array.begin(), container.array.end(), static_cast<std::uint16_t>(v));
+                    if (it == container.array.end() || *it != v) container.array.insert(it, static_cast<std::uint16_t>(v));
+                }
+                container.cardinality = static_cast<std::uint32_t>(container.array.size());
+            } else {
+                if (!container.isBitmap()) container.toBitmap();
+                for (std::uint32_t v = low; v <= high;) {
+                    if ((v & 63) == 0 && v + 63 <= high) {
+                        container.bits[v >> 6] = ~std::uint64_t(0);
+                        v += 64;
+                    } else {
+                        container.bits[v >> 6] |= std::uint64_t(1) << (v & 63);
+                        ++v;
+                    }
+                }
+                container.cardinality = 0;
+                for (std::uint64_t word : container.bits) container.cardinality += static_cast<std::uint32_t>(std::popcount(word));
+                container.compact();
+            }
+            if (key == last >> 16) break;
+        }
+    }
+
+    bool contains(IPv4 address) const {
+        const Container* container = findContainer(static_cast<std::uint16_t>(address.toUint32() >> 16));
+        return container != nullptr && container->contains(static_cast<std::uint16_t>(address.toUint32()));
+    }
+
+    std::uint64_t size() const {
+        std::uint64_t count = 0;
+        for (const Container& container : containers) count += container.cardinality;
+        return count;
+    }
+
+    bool empty() const { return containers.empty(); }
+
+    std::size_t memoryBytes() const {
+        std::size_t bytes = containers.capacity() * sizeof(Container);
+        for (const Container& container : containers) {
+            bytes += container.array.capacity() * sizeof(std::uint16_t) + container.bits.capacity() * sizeof(std::uint64_t);
+        }
+        return bytes;
+    }
+
+    // адреса по возрастанию
+    template<typename F>
+    void forEach(F&& function) const {
+        for (const Container& container : containers) {
+            std::uint32_t high = std::uint32_t(container.key) << 16;
+            container.forEach([&](std::uint16_t low) { function(IPv4(high | low)); });
+        }
+    }
+
+    friend bool operator==(const IPv4Set& lhs, const IPv4Set& rhs) {
+        if (lhs.containers.size() != rhs.containers.size()) return false;
+        for (std::size_t i = 0; i < lhs.containers.size(); ++i) {
+            const Container& a = lhs.containers[i];
+            const Container& b = rhs.containers[i];
+            // вид контейнера однозначно задан мощностью, поэтому достаточно сравнить содержимое
+            if (a.key != b.key || a.cardinality != b.cardinality || a.array != b.array || a.bits != b.bits) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend IPv4Set operator|(const IPv4Set& lhs, const IPv4Set& rhs) {
+        IPv4Set result;
+        result.containers.reserve(lhs.containers.size() + rhs.containers.size());
+        std::size_t i = 0, j = 0;
+        while (i < lhs.containers.size() || j < rhs.containers.size()) {
+            if (j == rhs.containers.size() || (i < lhs.containers.size() && lhs.containers[i].key < rhs.containers[j].key)) {
+                result.containers.push_back(lhs.containers[i++]);
+            } else if (i == lhs.containers.size() || rhs.containers[j].key < lhs.containers[i].key) {
+                result.containers.push_back(rhs.containers[j++]);
+            } else {
+                result.append(unite(lhs.containers[i++], rhs.containers[j++]));
+            }
+        }
+        return result;
+    }
+
+    friend IPv4Set operator&(const IPv4Set& lhs, const IPv4Set& rhs) {
+        IPv4Set result;
+        std::size_t i = 0, j = 0;
+        while (i < lhs.containers.size() && j < rhs.containers.size()) {
+            if (lhs.containers[i].key < rhs.containers[j].key) {
+                ++i;
+            } else if (rhs.containers[j].key < lhs.containers[i].key) {
+                ++j;
+            } else {
+                result.append(intersect(lhs.containers[i++], rhs.containers[j++]));
+            }
+        }
+        return result;
+    }
+
+    friend IPv4Set operator-(const IPv4Set& lhs, const IPv4Set& rhs) {
+        IPv4Set result;
+        std::size_t j = 0;
+        for (const Container& container : lhs.containers) {
+            while (j < rhs.containers.size() && rhs.containers[j].key < container.key) ++j;
+            if (j < rhs.containers.size() && rhs.containers[j].key == container.key) {
+                result.append(subtract(container, rhs.containers[j]));
+            } else {
+                result.containers.push_back(container);
+            }
+        }
+        return result;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// IPv6: 128 бит в двух словах порядка хоста; разбор с "::" и IPv4 в хвосте,
+// вывод по RFC 5952, префиксы через тот же BasicPrefix
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+constexpr std::array<std::uint8_t, 256> makeHexValues() {
+    std::array<std::uint8_t, 256> table{};
+    for (int c = 0; c < 256; ++c) {
+        table[c] = c >= '0' && c <= '9' ? static_cast<std::uint8_t>(c - '0')
+                 : c >= 'a' && c <= 'f' ? static_cast<std::uint8_t>(c - 'a' + 10)
+                 : c >= 'A' && c <= 'F' ? static_cast<std::uint8_t>(c - 'A' + 10)
+                 : 0xFF;
+    }
+    return table;
+}
+
+inline constexpr std::array<std::uint8_t, 256> hexValues = makeHexValues();
+
+class IPv6 {
+private:
+    std::uint64_t high; // группы 0..3
+    std::uint64_t low;  // группы 4..7
+
+    static std::uint8_t hexValue(char c) {
+        return hexValues[static_cast<unsigned char>(c)];
+    }
+
+    // группа строчными буквами без ведущих нулей
+    static char* writeGroup(char* out, std::uint16_t group) {
+        static constexpr char digits[] = "0123456789abcdef";
+        int nibbles = group == 0 ? 1 : (16 - std::countl_zero(group) + 3) / 4;
+        for (int i = nibbles - 1; i >= 0; --i) {
+            *out++ = digits[group >> (4 * i) & 0xF];
+        }
+        return out;
+    }
+
+    // нужно не больше maxTextLength байт
+    char* writeText(char* out) const {
+        // ::ffff:a.b.c.d - адрес IPv4 в IPv6, RFC 5952 раздел 5
+        if (high == 0 && low >> 32 == 0xFFFF) {
+            std::memcpy(out, "::ffff:", 7);
+            return to_chars(out + 7, out + 7 + IPv4::maxTextLength, IPv4(static_cast<std::uint32_t>(low))).ptr;
+        }
+        // самая длинная серия нулевых групп, не короче двух; при равенстве первая
+        int bestStart = -1, bestLength = 1;
+        for (int i = 0; i < 8;) {
+            if (group(i) != 0) {
+                ++i;
+                continue;
+            }
+            int j = i;
+            while (j < 8 && group(j) == 0) ++j;
+            if (j - i > bestLength) {
+                bestStart = i;
+                bestLength = j - i;
+            }
+            i = j;
+        }
+        for (int i = 0; i < 8; ++i) {
+            if (i == bestStart) {
+                *out++ = ':';
+                *out++ = ':';
+                i += bestLength - 1;
+                continue;
+            }
+            if (i > 0 && i != bestStart + bestLength) *out++ = ':';
+            out = writeGroup(out, group(i));
+        }
+        return out;
+    }
 
 public:
-    IPv4() : data{0, 0, 0, 0} {}
-    
-    IPv4(std::uint8_t a, std::uint8_t b, std::uint8_t c, std::uint8_t d) 
-        : data{a, b, c, d} {}
-    
-    IPv4& operator++() {
-        for (int i = 3; i >= 0; --i) {
-            if (data[i] < 255) {
-                ++data[i];
-                break;
-            } else {
-                data[i] = 0;
-            }
+    static constexpr std::size_t maxTextLength = 39;
+    static constexpr int bitCount = 128;
+
+    constexpr IPv6() : high(0), low(0) {}
+    constexpr IPv6(std::uint64_t highBits, std::uint64_t lowBits) : high(highBits), low(lowBits) {}
+
+    explicit constexpr IPv6(const std::array<std::uint16_t, 8>& groups) : high(0), low(0) {
+        for (int i = 0; i < 4; ++i) {
+            high = high << 16 | groups[i];
+            low = low << 16 | groups[i + 4];
+        }
+    }
+
+    // ::ffff:a.b.c.d
+    static constexpr IPv6 mapped(IPv4 address) {
+        return IPv6(0, 0xFFFF00000000ULL | address.toUint32());
+    }
+
+    constexpr std::optional<IPv4> toMappedIPv4() const {
+        if (high != 0 || low >> 32 != 0xFFFF) return std::nullopt;
+        return IPv4(static_cast<std::uint32_t>(low));
+    }
+
+    constexpr std::uint64_t highBits() const { return high; }
+    constexpr std::uint64_t lowBits() const { return low; }
+
+    constexpr std::uint16_t group(int index) const {
+        return static_cast<std::uint16_t>((index < 4 ? high : low) >> (48 - 16 * (index % 4)));
+    }
+
+    constexpr IPv6 maskedTo(int length) const {
+        if (length <= 64) {
+            return IPv6(length == 0 ? 0 : high & ~std::uint64_t(0) << (64 - length), 0);
+        }
+        return IPv6(high, low & ~std::uint64_t(0) << (128 - length));
+    }
+
+    constexpr IPv6 withHostBits(int length) const {
+        if (length <= 64) {
+            return IPv6(length == 64 ? high : high | ~std::uint64_t(0) >> length, ~std::uint64_t(0));
         }
+        return IPv6(high, length == 128 ? low : low | ~std::uint64_t(0) >> (length - 64));
+    }
+
+    // арифметика по модулю 2^128
+    IPv6& operator++() {
+        high += (++low == 0);
         return *this;
     }
-    
-    IPv4 operator++(int) {
-        IPv4 temp = *this;
+
+    IPv6 operator++(int) {
+        IPv6 temp = *this;
         ++(*this);
         return temp;
     }
-    
-    IPv4& operator--() {
-        for (int i = 3; i >= 0; --i) {
-            if (data[i] > 0) {
-                --data[i];
-                break;
-            } else {
-                data[i] = 255;
-            }
-        }
+
+    IPv6& operator--() {
+        high -= (low-- == 0);
         return *this;
     }
-    
-    IPv4 operator--(int) {
-        IPv4 temp = *this;
+
+    IPv6 operator--(int) {
+        IPv6 temp = *this;
         --(*this);
         return temp;
     }
-    
-    friend bool operator==(const IPv4& lhs, const IPv4& rhs) {
-        return lhs.data == rhs.data;
+
+    IPv6& operator+=(std::uint64_t offset) {
+        low += offset;
+        high += (low < offset);
+        return *this;
     }
-    
-    friend bool operator!=(const IPv4& lhs, const IPv4& rhs) {
+
+    IPv6& operator-=(std::uint64_t offset) {
+        high -= (low < offset);
+        low -= offset;
+        return *this;
+    }
+
+    friend IPv6 operator+(IPv6 ip, std::uint64_t offset) {
+        return ip += offset;
+    }
+
+    friend IPv6 operator-(IPv6 ip, std::uint64_t offset) {
+        return ip -= offset;
+    }
+
+    friend bool operator==(const IPv6& lhs, const IPv6& rhs) {
+        return lhs.high == rhs.high && lhs.low == rhs.low;
+    }
+
+    friend bool operator!=(const IPv6& lhs, const IPv6& rhs) {
         return !(lhs == rhs);
     }
-    
-    friend bool operator<(const IPv4& lhs, const IPv4& rhs) {
-        return lhs.data < rhs.data;
+
+    friend bool operator<(const IPv6& lhs, const IPv6& rhs) {
+        return lhs.high != rhs.high ? lhs.high < rhs.high : lhs.low < rhs.low;
     }
-    
-    friend bool operator>(const IPv4& lhs, const IPv4& rhs) {
+
+    friend bool operator>(const IPv6& lhs, const IPv6& rhs) {
         return rhs < lhs;
     }
-    
-    friend bool operator<=(const IPv4& lhs, const IPv4& rhs) {
+
+    friend bool operator<=(const IPv6& lhs, const IPv6& rhs) {
         return !(rhs < lhs);
     }
-    
-    friend bool operator>=(const IPv4& lhs, const IPv4& rhs) {
+
+    friend bool operator>=(const IPv6& lhs, const IPv6& rhs) {
         return !(lhs < rhs);
     }
-    
-    friend std::stringstream& operator<<(std::stringstream& ss, const IPv4& ip) {
-        ss << static_cast<int>(ip.data[0]) << '.' 
-           << static_cast<int>(ip.data[1]) << '.' 
-           << static_cast<int>(ip.data[2]) << '.' 
-           << static_cast<int>(ip.data[3]);
+
+    // Разбор в стиле std::from_chars: до восьми групп по 1..4 шестнадцатеричные цифры, одно "::"
+    // на место одной или нескольких нулевых групп, в конце может стоять адрес IPv4
+    friend std::from_chars_result from_chars(const char* first, const char* last, IPv6& ip) {
+        std::array<std::uint16_t, 8> groups{};
+        int count = 0;
+        int gap = -1; // сколько групп стоит перед "::"
+        const char* p = first;
+        if (last - p >= 2 && p[0] == ':' && p[1] == ':') {
+            gap = 0;
+            p += 2;
+        }
+        while (count < 8) {
+            // после "::" группы может и не быть
+            if (gap == count && (p == last || hexValue(*p) > 15)) break;
+            const char* start = p;
+            unsigned group = 0;
+            while (p != last && hexValue(*p) <= 15 && p - start < 4) {
+                group = group << 4 | hexValue(*p);
+                ++p;
+            }
+            if (p == start) return {p, std::errc::invalid_argument};
+            if (p != last && *p == '.') {
+                // IPv4 занимает две последние группы
+                if (count > (gap >= 0 ? 5 : 6)) return {start, std::errc::invalid_argument};
+                IPv4 tail;
+                auto result = from_chars(start, last, tail);
+                if (result.ec != std::errc{}) return result;
+                groups[count++] = static_cast<std::uint16_t>(tail.toUint32() >> 16);
+                groups[count++] = static_cast<std::uint16_t>(tail.toUint32());
+                p = result.ptr;
+                break;
+            }
+            if (p != last && hexValue(*p) <= 15) return {start, std::errc::result_out_of_range};
+            groups[count++] = static_cast<std::uint16_t>(group);
+            if (count == 8 || p == last || *p != ':') break;
+            if (last - p >= 2 && p[1] == ':') {
+                if (gap >= 0) return {p, std::errc::invalid_argument};
+                gap = count;
+                p += 2;
+            } else {
+                ++p;
+            }
+        }
+        if (gap < 0 ? count != 8 : count == 8) return {p, std::errc::invalid_argument};
+        if (gap >= 0) {
+            std::copy_backward(groups.begin() + gap, groups.begin() + count, groups.end());
+            std::fill(groups.begin() + gap, groups.begin() + gap + (8 - count), std::uint16_t(0));
+        }
+        ip = IPv6(groups);
+        return {p, std::errc{}};
+    }
+
+    static std::optional<IPv6> parse(std::string_view text, std::size_t* errorPosition = nullptr) {
+        IPv6 ip;
+        auto [ptr, ec] = from_chars(text.data(), text.data() + text.size(), ip);
+        if (ec == std::errc{} && ptr == text.data() + text.size()) {
+            return ip;
+        }
+        if (errorPosition) {
+            *errorPosition = static_cast<std::size_t>(ptr - text.data());
+        }
+        return std::nullopt;
+    }
+
+    friend std::to_chars_result to_chars(char* first, char* last, const IPv6& ip) {
+        if (last - first >= static_cast<std::ptrdiff_t>(maxTextLength)) {
+            return {ip.writeText(first), std::errc{}};
+        }
+        char buffer[maxTextLength];
+        std::size_t length = static_cast<std::size_t>(ip.writeText(buffer) - buffer);
+        if (length > static_cast<std::size_t>(last - first)) {
+            return {last, std::errc::value_too_large};
+        }
+        std::memcpy(first, buffer, length);
+        return {first + length, std::errc{}};
+    }
+
+    friend std::stringstream& operator<<(std::stringstream& ss, const IPv6& ip) {
+        char buffer[maxTextLength];
+        auto result = to_chars(buffer, buffer + sizeof(buffer), ip);
+        ss.write(buffer, result.ptr - buffer);
         return ss;
     }
-    
-    friend std::stringstream& operator>>(std::stringstream& ss, IPv4& ip) {
-        int a{}, b{}, c{}, d{};
-        char dot1{}, dot2{}, dot3{};
-        
-        ss >> a >> dot1 >> b >> dot2 >> c >> dot3 >> d;
-        
-        if (dot1 != '.' || dot2 != '.' || dot3 != '.' ||
-            a < 0 || a > 255 || b < 0 || b > 255 || 
-            c < 0 || c > 255 || d < 0 || d > 255) {
+
+    friend std::stringstream& operator>>(std::stringstream& ss, IPv6& ip) {
+        std::string text;
+        ss >> text;
+        std::optional<IPv6> parsed = parse(text);
+        if (!parsed) {
             ss.setstate(std::ios::failbit);
             return ss;
         }
-        
-        ip.data[0] = static_cast<std::uint8_t>(a);
-        ip.data[1] = static_cast<std::uint8_t>(b);
-        ip.data[2] = static_cast<std::uint8_t>(c);
-        ip.data[3] = static_cast<std::uint8_t>(d);
-        
+        ip = *parsed;
         return ss;
     }
 };
 
-int main() {
+using IPv6Prefix = BasicPrefix<IPv6>;
+
+template<>
+struct std::hash<IPv6> {
+    std::size_t operator()(const IPv6& ip) const noexcept {
+        // splitmix64 над обоими словами
+        auto mix = [](std::uint64_t x) {
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ULL;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        };
+        return static_cast<std::size_t>(mix(ip.highBits() ^ mix(ip.lowBits())));
+    }
+};
+
+// Прежнее представление массивом октетов, оставлено для сравнения скорости
+class OctetArrayIPv4 {
+private:
+    std::array<std::uint8_t, 4> data;
+
+public:
+    OctetArrayIPv4(std::uint32_t value)
+        : data{static_cast<std::uint8_t>(value >> 24), static_cast<std::uint8_t>(value >> 16),
+               static_cast<std::uint8_t>(value >> 8), static_cast<std::uint8_t>(value)} {}
+
+    OctetArrayIPv4& operator++() {
+        for (int i = 3; i >= 0; --i) {
+            if (data[i] < 255) {
+                ++data[i];
+                break;
+            } else {
+                data[i] = 0;
+            }
+        }
+        return *this;
+    }
+
+    std::uint8_t octet(int index) const { return data[index]; }
+
+    friend bool operator==(const OctetArrayIPv4& lhs, const OctetArrayIPv4& rhs) {
+        return lhs.data == rhs.data;
+    }
+
+    friend bool operator<(const OctetArrayIPv4& lhs, const OctetArrayIPv4& rhs) {
+        return lhs.data < rhs.data;
+    }
+};
+
+#if defined(__cpp_lib_format)
+// Спецификации ширины и выравнивания как у строк: std::format("{:>15}", ip)
+template<>
+struct std::formatter<IPv4, char> : std::formatter<std::string_view, char> {
+    auto format(const IPv4& ip, std::format_context& context) const {
+        char buffer[IPv4::bulkBytesPerAddress];
+        auto result = to_chars(buffer, buffer + sizeof(buffer), ip);
+        return std::formatter<std::string_view, char>::format(
+            std::string_view(buffer, static_cast<std::size_t>(result.ptr - buffer)), context);
+    }
+};
+#endif
+
+template<typename F>
+long long measureMicroseconds(F&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+}
+
+void printLogScan(const char* title, const LogScanResult& result) {
+    std::cout << title << ": " << result.bytes << " bytes, " << result.lines << " lines, " << result.addresses
+              << " addresses, " << result.distinct << " distinct, " << result.gigabytesPerSecond() << " GB/s" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    // режим утилиты: 3.9 <журнал> [--first-field] [--bitmap] [--threads N]
+    if (argc > 1) {
+        auto usage = [](std::string_view problem) {
+            std::cerr << problem << "\nusage: 3.9 <журнал> [--first-field] [--bitmap] [--threads N]" << std::endl;
+            return 1;
+        };
+        LogScanOptions options;
+        for (int i = 2; i < argc; ++i) {
+            std::string_view argument = argv[i];
+            if (argument == "--first-field") {
+                options.firstFieldOnly = true;
+            } else if (argument == "--bitmap") {
+                options.counting = LogScanOptions::Counting::Bitmap;
+            } else if (argument == "--threads") {
+                if (i + 1 == argc) return usage("--threads needs a value");
+                std::string_view value = argv[++i];
+                auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), options.threads);
+                if (error != std::errc() || end != value.data() + value.size() || options.threads == 0) {
+                    return usage("invalid thread count: " + std::string(value));
+                }
+            } else {
+                return usage("unknown argument: " + std::string(argument));
+            }
+        }
+        std::optional<LogScanResult> result = scanLogFile(argv[1], options);
+        if (!result) {
+            std::cerr << "cannot read " << argv[1] << std::endl;
+            return 1;
+        }
+        printLogScan(argv[1], *result);
+        return 0;
+    }
+
     // конструкторы
     IPv4 ip1;
     IPv4 ip2(192, 168, 1, 1);
@@ -168,6 +1925,843 @@ int main() {
     --ip10;
     assert(ip10 == IPv4(255, 255, 255, 255));
     std::cout << "Edge cases test passed" << std::endl;
+
+    //  быстрый разбор
+    {
+        std::optional<IPv4> parsed = IPv4::parse("192.168.1.1");
+        assert(parsed && *parsed == IPv4(192, 168, 1, 1));
+        parsed = IPv4::parse("0.0.0.0");
+        assert(parsed && *parsed == IPv4());
+        parsed = IPv4::parse("255.255.255.255");
+        assert(parsed && *parsed == IPv4(255, 255, 255, 255));
+
+        struct BadInput {
+            const char* text;
+            std::size_t position;
+        };
+        const BadInput bad[] = {
+            {"", 0}, {"1.2.3", 5}, {"1.2.3.", 6}, {"1..3.4", 2}, {"256.1.1.1", 0}, {"1.2.3.4567", 6},
+            {"01.2.3.4", 0}, {"1.2.3.00", 6}, {"1.2.3.4.5", 7}, {"1.2.3.4 ", 7}, {" 1.2.3.4", 0}, {"1,2,3,4", 1},
+        };
+        for (const BadInput& input : bad) {
+            std::size_t position = 12345;
+            parsed = IPv4::parse(input.text, &position);
+            assert(!parsed && position == input.position);
+        }
+
+        // from_chars читает префикс, как std::from_chars
+        const char text[] = "10.0.0.1 GET /";
+        IPv4 ip;
+        auto [ptr, ec] = from_chars(text, text + sizeof(text) - 1, ip);
+        assert(ec == std::errc{} && ptr == text + 8 && ip == IPv4(10, 0, 0, 1));
+        auto empty = from_chars(text + 9, text + 9, ip);
+        assert(empty.ec == std::errc::invalid_argument && empty.ptr == text + 9);
+
+        // векторный вариант обязан совпадать со скалярным, включая позиции ошибок
+        std::mt19937 random(42);
+        const char alphabet[] = "0123456789..  x";
+        for (int i = 0; i < 200000; ++i) {
+            std::string candidate;
+            if (i % 2 == 0) {
+                candidate = std::to_string(random() % 300) + '.' + std::to_string(random() % 300) + '.' +
+                            std::to_string(random() % 260) + '.' + std::to_string(random() % 260);
+                if (i % 6 == 0) candidate[random() % candidate.size()] = alphabet[random() % 15];
+            } else {
+                std::size_t length = random() % 20;
+                for (std::size_t j = 0; j < length; ++j) candidate += alphabet[random() % 15];
+            }
+            IPv4 scalar, vectorized;
+            const char* begin = candidate.data();
+            const char* end = begin + candidate.size();
+            auto expected = from_chars(begin, end, scalar);
+            auto actual = from_chars_simd(begin, end, vectorized);
+            assert(expected.ptr == actual.ptr && expected.ec == actual.ec);
+            assert(expected.ec != std::errc{} || scalar == vectorized);
+        }
+    }
+    std::cout << "Fast parse test passed" << std::endl;
+
+    //  скорость разбора: адреса через '\n' в одном буфере
+    {
+        const int count = 10'000'000;
+        std::mt19937 random(7);
+        std::string log;
+        std::vector<std::size_t> offsets;
+        for (int i = 0; i < count; ++i) {
+            offsets.push_back(log.size());
+            std::uint32_t value = static_cast<std::uint32_t>(random());
+            log += std::to_string(value >> 24) + '.' + std::to_string(value >> 16 & 255) + '.' +
+                   std::to_string(value >> 8 & 255) + '.' + std::to_string(value & 255) + '\n';
+        }
+        const char* end = log.data() + log.size();
+        auto parseAll = [&](auto parser) {
+            unsigned checksum = 0;
+            IPv4 ip;
+            for (const char* p = log.data(); p < end;) {
+                auto result = parser(p, end, ip);
+                checksum += (ip == IPv4(1, 2, 3, 4));
+                p = result.ptr + 1;
+            }
+            return checksum;
+        };
+        unsigned scalarChecksum = 0, simdChecksum = 0;
+        long long scalarTime = measureMicroseconds([&] {
+            scalarChecksum = parseAll([](const char* a, const char* b, IPv4& ip) { return from_chars(a, b, ip); });
+        });
+        long long simdTime = measureMicroseconds([&] {
+            simdChecksum = parseAll([](const char* a, const char* b, IPv4& ip) { return from_chars_simd(a, b, ip); });
+        });
+        assert(scalarChecksum == simdChecksum);
+
+        const int streamCount = count / 10;
+        int streamParsed = 0;
+        long long streamTime = measureMicroseconds([&] {
+            for (int i = 0; i < streamCount; ++i) {
+                std::stringstream ss(log.substr(offsets[i], offsets[i + 1] - offsets[i] - 1));
+                IPv4 ip;
+                ss >> ip;
+                streamParsed += !ss.fail();
+            }
+        });
+        assert(streamParsed == streamCount);
+
+        auto perSecond = [](long long addresses, long long microseconds) {
+            return static_cast<double>(addresses) / (static_cast<double>(microseconds) + 1) * 1e6;
+        };
+        std::cout << "parse, million addresses/s: from_chars " << perSecond(count, scalarTime) / 1e6
+#if defined(__SSSE3__)
+                  << ", from_chars_simd (SSSE3) "
+#else
+                  << ", from_chars_simd (scalar fallback) "
+#endif
+                  << perSecond(count, simdTime) / 1e6 << ", stringstream operator>> "
+                  << perSecond(streamCount, streamTime) / 1e6 << std::endl;
+    }
+
+    //  форматирование
+    {
+        char buffer[IPv4::maxTextLength];
+        for (int value = 0; value < 256; ++value) {
+            std::uint8_t octet = static_cast<std::uint8_t>(value);
+            for (IPv4 ip : {IPv4(octet, 0, 0, 0), IPv4(1, octet, 2, 3), IPv4(255, 255, octet, 255), IPv4(9, 9, 9, octet)}) {
+                std::stringstream ss;
+                ss << ip;
+                auto [ptr, ec] = to_chars(buffer, buffer + sizeof(buffer), ip);
+                assert(ec == std::errc{} && std::string_view(buffer, ptr - buffer) == ss.str());
+            }
+        }
+        // буфер ровно по длине подходит, на байт короче - нет
+        IPv4 longest(255, 255, 255, 255);
+        auto exact = to_chars(buffer, buffer + 15, longest);
+        assert(exact.ec == std::errc{} && exact.ptr == buffer + 15);
+        auto tooSmall = to_chars(buffer, buffer + 14, longest);
+        assert(tooSmall.ec == std::errc::value_too_large && tooSmall.ptr == buffer + 14);
+
+        std::vector<IPv4> addresses = {IPv4(10, 0, 0, 1), IPv4(), longest, IPv4(192, 168, 100, 7)};
+        std::string text = "log:";
+        IPv4::formatBulk(addresses, text, ' ');
+        assert(text == "log:10.0.0.1 0.0.0.0 255.255.255.255 192.168.100.7 ");
+#if defined(__cpp_lib_format)
+        assert(std::format("[{}] [{:>12}]", IPv4(10, 0, 0, 1), IPv4(1, 2, 3, 4)) == "[10.0.0.1] [     1.2.3.4]");
+#endif
+    }
+    std::cout << "Format test passed" << std::endl;
+
+    //  скорость форматирования 1e8 адресов: пачками по 1e6 в один буфер
+    {
+        const int batch = 1'000'000;
+        const int rounds = 100;
+        std::mt19937 random(11);
+        std::vector<IPv4> addresses;
+        for (int i = 0; i < batch; ++i) {
+            std::uint32_t value = static_cast<std::uint32_t>(random());
+            addresses.emplace_back(value >> 24, value >> 16 & 255, value >> 8 & 255, value & 255);
+        }
+        std::string output(batch * IPv4::bulkBytesPerAddress, '\0');
+        std::size_t bulkBytes = 0, toCharsBytes = 0;
+        long long bulkTime = measureMicroseconds([&] {
+            for (int round = 0; round < rounds; ++round) {
+                bulkBytes += IPv4::formatBulk(addresses, output.data()) - output.data();
+            }
+        });
+        long long toCharsTime = measureMicroseconds([&] {
+            for (int round = 0; round < rounds; ++round) {
+                char* out = output.data();
+                char* end = out + output.size();
+                for (const IPv4& ip : addresses) {
+                    out = to_chars(out, end, ip).ptr;
+                    *out++ = '\n';
+                }
+                toCharsBytes += out - output.data();
+            }
+        });
+        assert(bulkBytes == toCharsBytes);
+
+        std::size_t streamBytes = 0;
+        long long streamTime = measureMicroseconds([&] {
+            std::stringstream ss;
+            for (const IPv4& ip : addresses) {
+                ss.str("");
+                ss << ip;
+                streamBytes += ss.str().size() + 1;
+            }
+        });
+        assert(streamBytes * rounds == bulkBytes);
+        std::cout << "format 1e8 addresses: formatBulk " << bulkTime / 1000 << " ms, to_chars " << toCharsTime / 1000
+                  << " ms, stringstream (1e6, scaled) " << streamTime * rounds / 1000 << " ms" << std::endl;
+    }
+
+    //  целочисленное представление
+    {
+        IPv4 ip(192, 168, 1, 2);
+        assert(ip.toUint32() == 0xC0A80102u && IPv4(0xC0A80102u) == ip);
+        assert(ip.octet(0) == 192 && ip.octet(3) == 2);
+        assert((ip.octets() == std::array<std::uint8_t, 4>{192, 168, 1, 2}));
+        assert(ip + 254 == IPv4(192, 168, 2, 0));
+        assert(ip - 3 == IPv4(192, 168, 0, 255));
+        assert(ip + (-3) == ip - 3);
+        assert(IPv4(255, 255, 255, 255) + 2 == IPv4(0, 0, 0, 1));
+        assert(distance(ip, IPv4(192, 168, 2, 0)) == 254);
+        assert(distance(IPv4(255, 255, 255, 255), IPv4()) == -4294967295LL);
+        IPv4 moved = ip;
+        moved += 1 << 24;
+        assert(moved == IPv4(193, 168, 1, 2) && moved > ip);
+
+        std::unordered_set<IPv4> seen;
+        for (IPv4 a(10, 0, 0, 0); a < IPv4(10, 0, 4, 0); ++a) seen.insert(a);
+        assert(seen.size() == 1024 && seen.count(IPv4(10, 0, 3, 255)) == 1 && seen.count(IPv4(10, 0, 4, 0)) == 0);
+        std::hash<IPv4> hasher;
+        assert(hasher(IPv4(1)) != hasher(IPv4(2)));
+    }
+    std::cout << "Integer representation test passed" << std::endl;
+
+    //  перебор 1e8 и сортировка 1e7 адресов: uint32 против массива октетов
+    {
+        const std::size_t count = 100'000'000;
+        std::uint64_t checksum = 0, arrayChecksum = 0;
+        long long iterateTime = measureMicroseconds([&] {
+            IPv4 ip(0x0A000000u);
+            for (std::size_t i = 0; i < count; ++i, ++ip) checksum += ip.octet(2);
+        });
+        long long arrayIterateTime = measureMicroseconds([&] {
+            OctetArrayIPv4 ip(0x0A000000u);
+            for (std::size_t i = 0; i < count; ++i, ++ip) arrayChecksum += ip.octet(2);
+        });
+        assert(checksum == arrayChecksum);
+
+        const std::size_t sortCount = count / 10;
+        std::mt19937 random(3);
+        std::vector<IPv4> addresses;
+        addresses.reserve(sortCount);
+        for (std::size_t i = 0; i < sortCount; ++i) addresses.emplace_back(static_cast<std::uint32_t>(random()));
+        std::vector<OctetArrayIPv4> arrays;
+        arrays.reserve(sortCount);
+        for (const IPv4& ip : addresses) arrays.emplace_back(ip.toUint32());
+        long long sortTime = measureMicroseconds([&] { std::sort(addresses.begin(), addresses.end()); });
+        long long arraySortTime = measureMicroseconds([&] { std::sort(arrays.begin(), arrays.end()); });
+        assert(std::is_sorted(addresses.begin(), addresses.end()) && arrays.back() == OctetArrayIPv4(addresses.back().toUint32()));
+        std::cout << "iterate 1e8: uint32 " << iterateTime / 1000 << " ms, octet array " << arrayIterateTime / 1000
+                  << " ms; sort 1e7: uint32 " << sortTime / 1000 << " ms, octet array " << arraySortTime / 1000 << " ms"
+                  << std::endl;
+    }
+
+    //  префиксы CIDR
+    {
+        std::optional<IPv4Prefix> prefix = IPv4Prefix::parse("10.1.2.3/8");
+        assert(prefix && prefix->network() == IPv4(10, 0, 0, 0) && prefix->length() == 8);
+        assert(prefix->broadcast() == IPv4(10, 255, 255, 255) && prefix->size() == (1u << 24));
+        assert(prefix->contains(IPv4(10, 200, 0, 1)) && !prefix->contains(IPv4(11, 0, 0, 0)));
+        std::optional<IPv4Prefix> all = IPv4Prefix::parse("0.0.0.0/0");
+        assert(all && all->contains(IPv4(255, 255, 255, 255)) && all->contains(*prefix) && !prefix->contains(*all));
+        std::optional<IPv4Prefix> host = IPv4Prefix::parse("192.168.1.1/32");
+        assert(host && host->size() == 1 && host->broadcast() == IPv4(192, 168, 1, 1));
+
+        std::stringstream ss;
+        ss << *prefix;
+        assert(ss.str() == "10.0.0.0/8");
+
+        struct BadInput {
+            const char* text;
+            std::size_t position;
+        };
+        const BadInput bad[] = {{"10.0.0.0", 8}, {"10.0.0.0/", 9}, {"10.0.0.0/33", 9}, {"10.0.0.0/08", 9},
+                                {"10.0.0.0/123", 9}, {"10.0.0/8", 6}, {"10.0.0.0/8 ", 10}};
+        for (const BadInput& input : bad) {
+            std::size_t position = 0;
+            prefix = IPv4Prefix::parse(input.text, &position);
+            assert(!prefix && position == input.position);
+        }
+    }
+    std::cout << "Prefix test passed" << std::endl;
+
+    //  таблица LPM против перебора всех маршрутов
+    {
+        std::mt19937 random(5);
+        std::vector<IPv4Route> routes;
+        for (std::uint32_t i = 0; i < 2000; ++i) {
+            int length = static_cast<int>(random() % 33);
+            // часть префиксов вложена в одну /16, чтобы проверить перекрытия и длинные маски
+            std::uint32_t base = i % 2 ? static_cast<std::uint32_t>(random()) : 0xC0A80000u | (random() & 0xFFFF);
+            routes.push_back({IPv4Prefix(IPv4(base), length), i});
+        }
+        IPv4LpmTable table(routes);
+        auto bruteForce = [&](IPv4 address) {
+            std::uint32_t best = IPv4LpmTable::noRoute;
+            int bestLength = -1;
+            for (const IPv4Route& route : routes) {
+                if (route.prefix.contains(address) && route.prefix.length() >= bestLength) {
+                    best = route.nextHop;
+                    bestLength = route.prefix.length();
+                }
+            }
+            return best;
+        };
+        std::vector<IPv4> queries;
+        for (int i = 0; i < 3000; ++i) {
+            std::uint32_t value = static_cast<std::uint32_t>(random());
+            queries.emplace_back(i % 2 ? value : 0xC0A80000u | (value & 0xFFFF));
+        }
+        std::vector<std::uint32_t> batched(queries.size());
+        table.lookup(queries, batched);
+        for (std::size_t i = 0; i < queries.size(); ++i) {
+            std::uint32_t expected = bruteForce(queries[i]);
+            assert(table.lookup(queries[i]) == expected && batched[i] == expected);
+        }
+        std::vector<IPv4Route> empty;
+        IPv4LpmTable emptyTable(empty);
+        assert(emptyTable.lookup(IPv4(1, 2, 3, 4)) == IPv4LpmTable::noRoute);
+    }
+    std::cout << "LPM table test passed" << std::endl;
+
+    //  скорость LPM: 500 тысяч префиксов с распределением длин как в таблицах BGP
+    {
+        std::mt19937 random(17);
+        // доли длин /8../32 примерно как в полной таблице: больше половины /24
+        const int weights[33] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 2, 4, 8, 15, 20, 120, 40, 70, 150, 250, 350,
+                                 700, 750, 5500, 0, 2, 4, 8, 10, 10, 0, 5};
+        std::discrete_distribution<int> lengths(std::begin(weights), std::end(weights));
+        std::vector<IPv4Route> routes;
+        const std::size_t prefixCount = 500'000;
+        for (std::size_t i = 0; i < prefixCount; ++i) {
+            routes.push_back({IPv4Prefix(IPv4(static_cast<std::uint32_t>(random())), lengths(random)),
+                              static_cast<std::uint32_t>(random() % 4096)});
+        }
+        std::optional<IPv4LpmTable> table;
+        long long buildTime = measureMicroseconds([&] { table.emplace(routes); });
+
+        // половина трафика - адреса внутри анонсированных префиксов, половина - случайные
+        const std::size_t queryCount = 20'000'000;
+        std::vector<IPv4> queries;
+        queries.reserve(queryCount);
+        for (std::size_t i = 0; i < queryCount; ++i) {
+            std::uint32_t value = static_cast<std::uint32_t>(random());
+            if (i % 2) {
+                const IPv4Prefix& prefix = routes[value % prefixCount].prefix;
+                value = prefix.network().toUint32() | (static_cast<std::uint32_t>(random()) & ~prefix.mask());
+            }
+            queries.emplace_back(value);
+        }
+        std::uint64_t singleSum = 0;
+        long long singleTime = measureMicroseconds([&] {
+            for (const IPv4& query : queries) singleSum += table->lookup(query);
+        });
+        std::vector<std::uint32_t> nextHops(queryCount);
+        long long batchTime = measureMicroseconds([&] { table->lookup(queries, nextHops); });
+        std::uint64_t batchSum = 0;
+        for (std::uint32_t hop : nextHops) batchSum += hop;
+        assert(singleSum == batchSum);
+        std::cout << "LPM over " << prefixCount << " prefixes: build " << buildTime / 1000 << " ms, "
+                  << table->memoryBytes() / (1024 * 1024) << " MiB, " << table->groups() << " /24 groups; "
+                  << "million lookups/s: single " << static_cast<double>(queryCount) / static_cast<double>(singleTime + 1)
+                  << ", batched " << static_cast<double>(queryCount) / static_cast<double>(batchTime + 1) << std::endl;
+    }
+
+    //  множества диапазонов против побитового эталона на малом пространстве
+    {
+        std::mt19937 random(23);
+        auto randomSet = [&](std::vector<bool>& bits) {
+            std::vector<IPv4Interval> intervals;
+            int count = static_cast<int>(random() % 12);
+            for (int i = 0; i < count; ++i) {
+                std::uint32_t first = random() % 1000;
+                std::uint32_t last = std::min<std::uint32_t>(1023, first + random() % 40);
+                intervals.emplace_back(IPv4(first), IPv4(last));
+                for (std::uint32_t v = first; v <= last; ++v) bits[v] = true;
+            }
+            return intervals;
+        };
+        for (int round = 0; round < 300; ++round) {
+            std::vector<bool> a(1024), b(1024);
+            std::vector<IPv4Interval> left = randomSet(a);
+            std::vector<IPv4Interval> right = randomSet(b);
+            IPv4RangeSet setA(left, round % 2 ? IPv4RangeSet::Layout::Eytzinger : IPv4RangeSet::Layout::Sorted);
+            IPv4RangeSet setB(right);
+            IPv4RangeSet incremental;
+            incremental.setLayout(IPv4RangeSet::Layout::Eytzinger);
+            for (const IPv4Interval& interval : left) incremental.insert(interval);
+            assert(incremental == setA);
+            IPv4RangeSet united = setA | setB;
+            IPv4RangeSet common = setA & setB;
+            IPv4RangeSet rest = setA - setB;
+            std::uint64_t countA = 0;
+            for (std::uint32_t v = 0; v < 1024; ++v) {
+                IPv4 address(v);
+                countA += a[v];
+                assert(setA.contains(address) == a[v] && incremental.contains(address) == a[v]);
+                assert(united.contains(address) == (a[v] || b[v]));
+                assert(common.contains(address) == (a[v] && b[v]));
+                assert(rest.contains(address) == (a[v] && !b[v]));
+            }
+            assert(setA.addressCount() == countA);
+            // нормализация: между соседними диапазонами есть хотя бы один адрес
+            std::vector<IPv4Interval> parts = united.intervals();
+            for (std::size_t i = 1; i < parts.size(); ++i) {
+                assert(parts[i - 1].last.toUint32() + 1 < parts[i].first.toUint32());
+            }
+        }
+
+        // границы пространства адресов и источники разного вида
+        std::vector<IPv4Interval> edges = {IPv4Interval(IPv4(0, 0, 0, 0)), IPv4Interval(*IPv4Prefix::parse("255.0.0.0/8")),
+                                           IPv4Interval(IPv4(254, 255, 255, 255))};
+        IPv4RangeSet edgeSet(edges, IPv4RangeSet::Layout::Eytzinger);
+        assert(edgeSet.size() == 2 && edgeSet.contains(IPv4(255, 255, 255, 255)) && edgeSet.contains(IPv4()));
+        assert(!edgeSet.contains(IPv4(0, 0, 0, 1)) && edgeSet.contains(IPv4(254, 255, 255, 255)));
+        std::vector<IPv4Interval> everything = {IPv4Interval(*IPv4Prefix::parse("0.0.0.0/0"))};
+        IPv4RangeSet complement = IPv4RangeSet(everything) - edgeSet;
+        assert(complement.size() == 1 && complement.addressCount() == (std::uint64_t(1) << 32) - 1 - (1 << 24) - 1);
+        assert((complement | edgeSet).addressCount() == std::uint64_t(1) << 32);
+    }
+    std::cout << "Range set test passed" << std::endl;
+
+    //  скорость проверки принадлежности при 1e6 диапазонов
+    {
+        std::mt19937 random(29);
+        const std::size_t rangeCount = 1'000'000;
+        std::vector<std::uint32_t> bounds(2 * rangeCount);
+        for (std::uint32_t& bound : bounds) bound = static_cast<std::uint32_t>(random());
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+        std::vector<IPv4Interval> intervals;
+        for (std::size_t i = 0; i + 1 < bounds.size(); i += 2) {
+            intervals.emplace_back(IPv4(bounds[i]), IPv4(bounds[i + 1]));
+        }
+        IPv4RangeSet sorted(intervals);
+        IPv4RangeSet eytzinger(intervals, IPv4RangeSet::Layout::Eytzinger);
+        std::vector<std::uint32_t> starts, ends;
+        for (const IPv4Interval& interval : intervals) {
+            starts.push_back(interval.first.toUint32());
+            ends.push_back(interval.last.toUint32());
+        }
+
+        const std::size_t queryCount = 10'000'000;
+        std::vector<IPv4> queries;
+        queries.reserve(queryCount);
+        for (std::size_t i = 0; i < queryCount; ++i) queries.emplace_back(static_cast<std::uint32_t>(random()));
+        std::size_t hits[3] = {};
+        long long upperBoundTime = measureMicroseconds([&] {
+            for (const IPv4& query : queries) {
+                auto it = std::upper_bound(starts.begin(), starts.end(), query.toUint32());
+                hits[0] += it != starts.begin() && query.toUint32() <= ends[it - starts.begin() - 1];
+            }
+        });
+        long long sortedTime = measureMicroseconds([&] {
+            for (const IPv4& query : queries) hits[1] += sorted.contains(query);
+        });
+        long long eytzingerTime = measureMicroseconds([&] {
+            for (const IPv4& query : queries) hits[2] += eytzinger.contains(query);
+        });
+        assert(hits[0] == hits[1] && hits[1] == hits[2]);
+        std::cout << "membership, " << sorted.size() << " ranges, 1e7 queries: std::upper_bound " << upperBoundTime / 1000
+                  << " ms, branchless " << sortedTime / 1000 << " ms, Eytzinger " << eytzingerTime / 1000 << " ms"
+                  << std::endl;
+    }
+
+    //  подсчет адресов в журнале
+    {
+        std::string_view log =
+            "10.0.0.1 - - [10/Oct/2024:13:55:36] \"GET /a HTTP/1.1\" 200 upstream=192.168.0.1\n"
+            "10.0.0.1 - - [10/Oct/2024:13:55:37] \"GET /b HTTP/1.1\" 404 upstream=192.168.0.1\n"
+            "bad 1.2.3.4.5 999.1.1.1 01.2.3.4 v1.2.3.4x\n" // из этой строки берется только 1.2.3.4
+            "255.255.255.255\n"
+            "\n"
+            "10.0.0.2";
+        for (unsigned threads : {1u, 2u, 3u, 16u}) {
+            LogScanOptions options;
+            options.threads = threads;
+            LogScanResult all = scanLog(log, options);
+            assert(all.lines == 6 && all.addresses == 7 && all.distinct == 5 && all.bytes == log.size());
+            options.firstFieldOnly = true;
+            LogScanResult first = scanLog(log, options);
+            assert(first.lines == 6 && first.addresses == 4 && first.distinct == 3);
+        }
+        LogScanOptions bitmapOptions;
+        bitmapOptions.counting = LogScanOptions::Counting::Bitmap;
+        bitmapOptions.threads = 2;
+        LogScanResult bitmapResult = scanLog(log, bitmapOptions);
+        assert(bitmapResult.addresses == 7 && bitmapResult.distinct == 5);
+        LogScanResult empty = scanLog("", bitmapOptions);
+        assert(empty.lines == 0 && empty.distinct == 0);
+
+        AddressHashSet set;
+        for (std::uint32_t i = 0; i < 100000; ++i) set.insert(IPv4(i * 7));
+        bool repeated = set.insert(IPv4(700));
+        assert(set.size() == 100000 && !repeated);
+        std::optional<LogScanResult> missing = scanLogFile("/nonexistent/3_9_access.log", LogScanOptions());
+        assert(!missing);
+    }
+    std::cout << "Log scan test passed" << std::endl;
+
+    //  журнал на ~200 МБ: 100 тысяч клиентов и 16 адресов бэкендов
+    {
+        std::mt19937 random(31);
+        std::vector<IPv4> clients;
+        std::unordered_set<IPv4> distinctClients;
+        for (int i = 0; i < 100'000; ++i) {
+            clients.emplace_back(static_cast<std::uint32_t>(random()));
+            distinctClients.insert(clients.back());
+        }
+        std::unordered_set<IPv4> distinctAll = distinctClients;
+        for (std::uint8_t i = 0; i < 16; ++i) distinctAll.insert(IPv4(172, 16, 0, i));
+
+        std::string text;
+        text.reserve(210'000'000);
+        char address[IPv4::bulkBytesPerAddress];
+        std::uint64_t lineCount = 0;
+        while (text.size() < 200'000'000) {
+            // по Ципфу: немногие клиенты дают большую часть строк
+            std::size_t client = static_cast<std::size_t>(std::pow(static_cast<double>(random() % 1'000'000) / 1e6, 3.0) * 100'000);
+            text.append(address, to_chars(address, address + sizeof(address), clients[client]).ptr);
+            text += " - - [10/Oct/2024:13:55:36 +0000] \"GET /static/app.js?v=1.2.3 HTTP/1.1\" 200 5123 "
+                    "\"-\" \"Mozilla/5.0 (X11; Linux x86_64)\" upstream=172.16.0.";
+            text += std::to_string(random() % 16);
+            text += '\n';
+            ++lineCount;
+        }
+        // все клиенты хотя бы раз
+        for (const IPv4& client : clients) {
+            text.append(address, to_chars(address, address + sizeof(address), client).ptr);
+            text += " - - \"GET / HTTP/1.1\" 200\n";
+            ++lineCount;
+        }
+        std::filesystem::path logPath = std::filesystem::temp_directory_path() / "3_9_access.log";
+        {
+            std::ofstream file(logPath, std::ios::binary | std::ios::trunc);
+            file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        }
+
+        unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        LogScanOptions options;
+        options.threads = 1;
+        options.firstFieldOnly = true;
+        std::optional<LogScanResult> result = scanLogFile(logPath, options);
+        assert(result && result->lines == lineCount && result->distinct == distinctClients.size());
+        printLogScan("client field, 1 thread", *result);
+        options.threads = hardwareThreads;
+        result = scanLogFile(logPath, options);
+        assert(result && result->distinct == distinctClients.size());
+        printLogScan("client field, all threads", *result);
+        options.firstFieldOnly = false;
+        result = scanLogFile(logPath, options);
+        assert(result && result->addresses == 2 * lineCount - clients.size() && result->distinct == distinctAll.size());
+        printLogScan("every address, hash sets", *result);
+        options.counting = LogScanOptions::Counting::Bitmap;
+        result = scanLogFile(logPath, options);
+        assert(result && result->distinct == distinctAll.size());
+        printLogScan("every address, bitmap", *result);
+        std::filesystem::remove(logPath);
+    }
+
+    //  перебор диапазона
+    {
+        static_assert(std::ranges::random_access_range<IPv4Range> && std::ranges::sized_range<IPv4Range>);
+        static_assert(std::ranges::view<IPv4Range>);
+        IPv4Range subnet(*IPv4Prefix::parse("192.168.1.0/30"));
+        std::vector<IPv4> listed;
+        for (IPv4 ip : subnet) listed.push_back(ip);
+        assert((listed == std::vector<IPv4>{IPv4(192, 168, 1, 0), IPv4(192, 168, 1, 1), IPv4(192, 168, 1, 2), IPv4(192, 168, 1, 3)}));
+        assert(subnet.size() == 4 && subnet[2] == IPv4(192, 168, 1, 2) && subnet.back() == IPv4(192, 168, 1, 3));
+
+        IPv4Range top(IPv4(255, 255, 255, 250), IPv4(255, 255, 255, 255));
+        assert(top.size() == 6 && std::ranges::distance(top) == 6);
+        assert(std::ranges::count_if(top, [](IPv4 ip) { return ip.octet(3) % 2 == 0; }) == 3);
+        auto found = std::ranges::find(top, IPv4(255, 255, 255, 255));
+        assert(found != top.end() && found - top.begin() == 5);
+        auto odd = top | std::views::filter([](IPv4 ip) { return ip.octet(3) % 2 == 1; });
+        assert(*std::ranges::begin(odd) == IPv4(255, 255, 255, 251));
+        IPv4Range everything(*IPv4Prefix::parse("0.0.0.0/0"));
+        assert(everything.size() == std::uint64_t(1) << 32 && everything.contains(IPv4(255, 255, 255, 255)));
+        assert(std::ranges::lower_bound(everything, IPv4(10, 0, 0, 0)) - everything.begin() == 10 << 24);
+    }
+    std::cout << "Range view test passed" << std::endl;
+
+    //  множество адресов против std::set
+    {
+        std::mt19937 random(37);
+        auto randomAddresses = [&](std::size_t count) {
+            std::vector<IPv4> addresses;
+            for (std::size_t i = 0; i < count; ++i) {
+                std::uint32_t value = static_cast<std::uint32_t>(random());
+                // треть в плотной /20, чтобы контейнеры переходили в битовые карты
+                addresses.emplace_back(i % 3 == 0 ? 0x0A000000u | (value & 0xFFF) : value & 0x0A0FFFFFu);
+            }
+            return addresses;
+        };
+        for (int round = 0; round < 20; ++round) {
+            std::vector<IPv4> left = randomAddresses(static_cast<std::size_t>(random() % 30000));
+            std::vector<IPv4> right = randomAddresses(static_cast<std::size_t>(random() % 30000));
+            IPv4Set a(left);
+            IPv4Set incremental;
+            for (const IPv4& ip : left) incremental.insert(ip);
+            assert(incremental == a);
+            IPv4Set b(right);
+            if (round % 2) {
+                IPv4Range block(IPv4(10, 0, 16, 5), IPv4(10, 2, 0, 77));
+                b.insert(block);
+                right.insert(right.end(), block.begin(), block.end());
+            }
+            std::set<IPv4> setA(left.begin(), left.end()), setB(right.begin(), right.end());
+            auto check = [](const IPv4Set& actual, const std::set<IPv4>& expected) {
+                assert(actual.size() == expected.size());
+                auto it = expected.begin();
+                actual.forEach([&](IPv4 ip) {
+                    assert(it != expected.end() && *it == ip);
+                    ++it;
+                });
+                for (const IPv4& ip : expected) assert(actual.contains(ip));
+            };
+            std::set<IPv4> expected;
+            check(a, setA);
+            check(b, setB);
+            std::set_union(setA.begin(), setA.end(), setB.begin(), setB.end(), std::inserter(expected, expected.end()));
+            check(a | b, expected);
+            expected.clear();
+            std::set_intersection(setA.begin(), setA.end(), setB.begin(), setB.end(), std::inserter(expected, expected.end()));
+            check(a & b, expected);
+            expected.clear();
+            std::set_difference(setA.begin(), setA.end(), setB.begin(), setB.end(), std::inserter(expected, expected.end()));
+            check(a - b, expected);
+            assert(!a.contains(IPv4(192, 168, 0, 1)));
+        }
+        // мощность 4096 и 4097 на границе массива и карты
+        IPv4Set border;
+        border.insert(IPv4Range(IPv4(1, 1, 0, 0), IPv4(1, 1, 15, 255)));
+        IPv4Set same(std::vector<IPv4>(IPv4Range(IPv4(1, 1, 0, 0), IPv4(1, 1, 15, 255)).begin(),
+                                       IPv4Range(IPv4(1, 1, 0, 0), IPv4(1, 1, 15, 255)).end()));
+        assert(border == same && border.size() == 4096);
+        bool added = border.insert(IPv4(1, 1, 16, 0));
+        assert(added && border.size() == 4097 && border.contains(IPv4(1, 1, 16, 0)));
+        assert((border - same).size() == 1 && (border & same) == same);
+    }
+    std::cout << "Address set test passed" << std::endl;
+
+    //  множества из 1e7 адресов: разреженные по всему пространству и плотные в /8
+    {
+        std::mt19937 random(41);
+        const std::size_t count = 10'000'000;
+        for (bool dense : {false, true}) {
+            std::vector<IPv4> first, second;
+            first.reserve(count);
+            second.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                std::uint32_t mask = dense ? 0x00FFFFFFu : 0xFFFFFFFFu;
+                std::uint32_t base = dense ? 0x0A000000u : 0;
+                first.emplace_back(base | (static_cast<std::uint32_t>(random()) & mask));
+                second.emplace_back(base | (static_cast<std::uint32_t>(random()) & mask));
+            }
+            IPv4Set a, b;
+            long long buildTime = measureMicroseconds([&] {
+                a = IPv4Set(first);
+                b = IPv4Set(second);
+            });
+            IPv4Set united;
+            long long unionTime = measureMicroseconds([&] { united = a | b; });
+            std::uint64_t checksum = 0;
+            long long iterateTime = measureMicroseconds([&] {
+                united.forEach([&](IPv4 ip) { checksum += ip.toUint32(); });
+            });
+
+            // то же на отсортированных векторах
+            std::vector<IPv4> sortedA = first, sortedB = second, sortedUnion;
+            long long vectorBuildTime = measureMicroseconds([&] {
+                std::sort(sortedA.begin(), sortedA.end());
+                sortedA.erase(std::unique(sortedA.begin(), sortedA.end()), sortedA.end());
+                std::sort(sortedB.begin(), sortedB.end());
+                sortedB.erase(std::unique(sortedB.begin(), sortedB.end()), sortedB.end());
+            });
+            long long vectorUnionTime = measureMicroseconds([&] {
+                sortedUnion.reserve(sortedA.size() + sortedB.size());
+                std::set_union(sortedA.begin(), sortedA.end(), sortedB.begin(), sortedB.end(), std::back_inserter(sortedUnion));
+            });
+            std::uint64_t vectorChecksum = 0;
+            long long vectorIterateTime = measureMicroseconds([&] {
+                for (const IPv4& ip : sortedUnion) vectorChecksum += ip.toUint32();
+            });
+            assert(united.size() == sortedUnion.size() && checksum == vectorChecksum);
+            std::cout << (dense ? "dense /8" : "sparse") << " 2x1e7: IPv4Set build " << buildTime / 1000 << " ms, union "
+                      << unionTime / 1000 << " ms, iterate " << iterateTime / 1000 << " ms, "
+                      << united.memoryBytes() / (1024 * 1024) << " MiB; sorted vector build " << vectorBuildTime / 1000
+                      << " ms, union " << vectorUnionTime / 1000 << " ms, iterate " << vectorIterateTime / 1000 << " ms, "
+                      << sortedUnion.capacity() * sizeof(IPv4) / (1024 * 1024) << " MiB" << std::endl;
+        }
+    }
+
+    //  IPv6
+    {
+        struct Canonical {
+            const char* input;
+            const char* output;
+        };
+        // примеры из RFC 5952 и крайние случаи
+        const Canonical canonical[] = {
+            {"2001:0db8:0000:0000:0000:0000:0002:0001", "2001:db8::2:1"},
+            {"2001:db8:0:0:1:0:0:1", "2001:db8::1:0:0:1"},
+            {"2001:0:0:1:0:0:0:1", "2001:0:0:1::1"},
+            {"2001:db8:0:1:1:1:1:1", "2001:db8:0:1:1:1:1:1"},
+            {"2001:DB8::ABCD", "2001:db8::abcd"},
+            {"::", "::"},
+            {"::1", "::1"},
+            {"1::", "1::"},
+            {"1:2:3:4:5:6:7::", "1:2:3:4:5:6:7:0"},
+            {"::ffff:192.0.2.1", "::ffff:192.0.2.1"},
+            {"::192.0.2.1", "::c000:201"},
+            {"64:ff9b::10.0.0.1", "64:ff9b::a00:1"},
+            {"1:2:3:4:5:6:1.2.3.4", "1:2:3:4:5:6:102:304"},
+            {"fe80:0:0:0:0:0:0:0", "fe80::"},
+            {"ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff", "ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff"},
+        };
+        for (const Canonical& entry : canonical) {
+            std::optional<IPv6> parsed = IPv6::parse(entry.input);
+            assert(parsed);
+            std::stringstream ss;
+            ss << *parsed;
+            assert(ss.str() == entry.output);
+            std::optional<IPv6> again = IPv6::parse(ss.str());
+            assert(again && *again == *parsed);
+        }
+
+        struct BadInput {
+            const char* text;
+            std::size_t position;
+        };
+        const BadInput bad[] = {
+            {"", 0}, {":", 0}, {":1::", 0}, {":::", 2}, {"1:::2", 3}, {"1::2::3", 4}, {"12345::", 0},
+            {"1:2:3:4:5:6:7", 13}, {"1:2:3:4:5:6:7:8:9", 15}, {"1::2:3:4:5:6:7:8", 16}, {"1:", 2}, {"g::", 0},
+            {"1:2:3:4:5:6:7:1.2.3.4", 14}, {"::ffff:1.2.3", 12}, {"::ffff:1.2.3.04", 13}, {"1::2 ", 4},
+        };
+        for (const BadInput& input : bad) {
+            std::size_t position = 999;
+            std::optional<IPv6> parsed = IPv6::parse(input.text, &position);
+            assert(!parsed && position == input.position);
+        }
+
+        IPv6 ip = *IPv6::parse("2001:db8::ffff:ffff:ffff:ffff");
+        ++ip;
+        assert(ip == *IPv6::parse("2001:db8:0:1::"));
+        --ip;
+        assert(ip == *IPv6::parse("2001:db8::ffff:ffff:ffff:ffff"));
+        assert(ip + 2 == *IPv6::parse("2001:db8:0:1::1") && (ip + 2) - 2 == ip);
+        IPv6 last = *IPv6::parse("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff");
+        assert(++last == IPv6() && --last > ip);
+        assert(IPv6::mapped(IPv4(10, 1, 2, 3)).toMappedIPv4() == IPv4(10, 1, 2, 3) && !ip.toMappedIPv4());
+        assert(ip.group(1) == 0xdb8 && ip.group(7) == 0xffff);
+
+        std::unordered_set<IPv6> seen;
+        IPv6 walker = *IPv6::parse("2001:db8::fff0");
+        for (int i = 0; i < 1000; ++i, ++walker) seen.insert(walker);
+        assert(seen.size() == 1000 && seen.count(*IPv6::parse("2001:db8::1:0")) == 1);
+
+        std::stringstream input("fe80::1%eth0 2001:db8::7");
+        IPv6 read;
+        input >> read;
+        assert(input.fail());
+        std::stringstream valid("2001:db8::7");
+        valid >> read;
+        assert(!valid.fail() && read == *IPv6::parse("2001:db8::7"));
+
+        std::optional<IPv6Prefix> prefix = IPv6Prefix::parse("2001:db8:abcd:12::1/64");
+        assert(prefix && prefix->network() == *IPv6::parse("2001:db8:abcd:12::") && prefix->length() == 64);
+        assert(prefix->lastAddress() == *IPv6::parse("2001:db8:abcd:12:ffff:ffff:ffff:ffff"));
+        assert(prefix->contains(*IPv6::parse("2001:db8:abcd:12:1:2:3:4")) && !prefix->contains(*IPv6::parse("2001:db8:abcd:13::")));
+        std::optional<IPv6Prefix> narrow = IPv6Prefix::parse("2001:db8:abcd:12:8000::/65");
+        assert(narrow && prefix->contains(*narrow) && !narrow->contains(*prefix));
+        assert(narrow->lastAddress() == *IPv6::parse("2001:db8:abcd:12:ffff:ffff:ffff:ffff"));
+        std::optional<IPv6Prefix> host = IPv6Prefix::parse("::1/128");
+        assert(host && host->contains(*IPv6::parse("::1")) && !host->contains(IPv6()));
+        std::optional<IPv6Prefix> none = IPv6Prefix::parse("::/0");
+        assert(none && none->contains(*IPv6::parse("ffff::")));
+        std::stringstream ss;
+        ss << *prefix;
+        assert(ss.str() == "2001:db8:abcd:12::/64");
+        std::size_t position = 0;
+        std::optional<IPv6Prefix> tooLong = IPv6Prefix::parse("::/129", &position);
+        assert(!tooLong && position == 3);
+        assert(!IPv6Prefix::parse("10.0.0.0/33") && IPv4Prefix::parse("10.0.0.0/32"));
+    }
+    std::cout << "IPv6 test passed" << std::endl;
+
+    //  скорость разбора и вывода IPv6
+    {
+        std::mt19937_64 random(43);
+        const std::size_t count = 2'000'000;
+        std::vector<IPv6> addresses;
+        for (std::size_t i = 0; i < count; ++i) {
+            // как в живом трафике: у многих адресов длинные серии нулей
+            std::uint64_t high = 0x20010db800000000ULL | (random() & 0xFFFFFFFF);
+            std::uint64_t low = i % 3 == 0 ? random() % 0x10000 : i % 3 == 1 ? random() : random() & 0xFFFF0000FFFFULL;
+            addresses.emplace_back(high, low);
+        }
+        std::string text(count * (IPv6::maxTextLength + 1), '\0');
+        char* out = text.data();
+        long long formatTime = measureMicroseconds([&] {
+            for (const IPv6& ip : addresses) {
+                out = to_chars(out, out + IPv6::maxTextLength, ip).ptr;
+                *out++ = '\n';
+            }
+        });
+        text.resize(static_cast<std::size_t>(out - text.data()));
+        std::size_t parsed = 0;
+        long long parseTime = measureMicroseconds([&] {
+            const char* end = text.data() + text.size();
+            std::size_t i = 0;
+            for (const char* p = text.data(); p < end; ++i) {
+                IPv6 ip;
+                auto result = from_chars(p, end, ip);
+                parsed += result.ec == std::errc{} && ip == addresses[i];
+                p = result.ptr + 1;
+            }
+        });
+        assert(parsed == count);
+        std::cout << "IPv6, million/s: to_chars " << static_cast<double>(count) / static_cast<double>(formatTime + 1)
+                  << ", from_chars " << static_cast<double>(count) / static_cast<double>(parseTime + 1);
+#if !defined(_WIN32)
+        // для сравнения inet_ntop/inet_pton из libc
+        std::vector<std::string> lines;
+        std::stringstream all(text);
+        for (std::string line; std::getline(all, line);) lines.push_back(line);
+        char buffer[INET6_ADDRSTRLEN];
+        std::size_t agree = 0;
+        long long ntopTime = measureMicroseconds([&] {
+            for (const IPv6& ip : addresses) {
+                unsigned char bytes[16];
+                for (int g = 0; g < 8; ++g) {
+                    bytes[2 * g] = static_cast<unsigned char>(ip.group(g) >> 8);
+                    bytes[2 * g + 1] = static_cast<unsigned char>(ip.group(g));
+                }
+                inet_ntop(AF_INET6, bytes, buffer, sizeof(buffer));
+            }
+        });
+        long long ptonTime = measureMicroseconds([&] {
+            for (const std::string& line : lines) {
+                unsigned char bytes[16];
+                agree += inet_pton(AF_INET6, line.c_str(), bytes) == 1;
+            }
+        });
+        assert(agree == count);
+        std::cout << "; libc inet_ntop " << static_cast<double>(count) / static_cast<double>(ntopTime + 1)
+                  << ", inet_pton " << static_cast<double>(count) / static_cast<double>(ptonTime + 1);
+#endif
+        std::cout << std::endl;
+    }
     
     return 0;
 }
\ No newline at end of file